@@ -41,6 +41,34 @@ def run_parameter_sweep(num_samples=100, num_reruns=5, num_sims=10, num_timestep
     latest_csv = max(csv_files, key=lambda x: os.path.getctime(os.path.join(output_dir, x)))
     return pd.read_csv(os.path.join(output_dir, latest_csv))
 
+# Fixed-width agent record written by TrajectoryRecorder (see
+# include/trajectory_recorder.hpp for the file layout)
+TRAJECTORY_DTYPE = np.dtype([('x', '<u2'), ('y', '<u2'), ('type', 'u1'), ('pad', 'u1')])
+
+def load_trajectory(path):
+    """Load a binary trajectory file produced with recordTrajectory enabled.
+
+    Returns a list of (step, agents) tuples where agents is a DataFrame
+    with columns x, y (unit-world floats) and type (0 = prey, 1 = predator).
+    """
+    steps = []
+    with open(path, 'rb') as f:
+        magic = f.read(8)
+        if magic != b'PPTRAJ01':
+            raise ValueError(f"Not a trajectory file: {path}")
+        while True:
+            header = np.fromfile(f, dtype='<u4', count=2)
+            if header.size < 2:
+                break
+            step, count = int(header[0]), int(header[1])
+            records = np.fromfile(f, dtype=TRAJECTORY_DTYPE, count=count)
+            steps.append((step, pd.DataFrame({
+                'x': records['x'] / 65535.0,
+                'y': records['y'] / 65535.0,
+                'type': records['type'],
+            })))
+    return steps
+
 def plot_results(df):
     """Create visualizations of the parameter sweep results"""
     # Set up the plotting style
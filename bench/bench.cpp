@@ -0,0 +1,166 @@
+#include "simulation_controller.hpp"
+#include "simulation_config.hpp"
+#include "agent_pool.hpp"
+#include "grid.hpp"
+#include "lhs_sampler.hpp"
+#include "rng.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Micro-benchmarks for the spatial and stepping hot paths. Each case
+// prints one CSV row to stdout:
+//
+//   benchmark,variant,iterations,total_ms,per_op_us,ops_per_sec
+//
+// so per-commit throughput can be tracked by appending the output to a
+// log. Run via the `bench` build target. All cases use a fixed rngSeed
+// so repeated runs on the same machine time the same work.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const std::string& benchmark, const std::string& variant,
+            size_t iterations, double totalMs) {
+    double perOpUs = (totalMs * 1000.0) / static_cast<double>(iterations);
+    double opsPerSec = static_cast<double>(iterations) / (totalMs / 1000.0);
+    std::cout << benchmark << ',' << variant << ',' << iterations << ','
+              << totalMs << ',' << perOpUs << ',' << opsPerSec << '\n';
+}
+
+// The reference configuration from main.cpp, with a fixed seed
+SimulationConfig baseConfig() {
+    SimulationConfig config;
+    config.worldWidth = 1.0;
+    config.worldHeight = 1.0;
+    config.initialPredators = 30;
+    config.initialPrey = 500;
+    config.MF = 0.05;
+    config.MR = 0.03;
+    config.interactionRadius = 0.02;
+    config.cellSize = 0.02;
+    config.simulationSteps = 1000;
+    config.randomizeInitialPositions = true;
+    config.NR = 446;
+    config.RR = 0.1;
+    config.DR = 1;
+    config.DF = 0.0733333;
+    config.RF = 0.443333;
+    config.saveStatistics = false;
+    config.rngSeed = 0x5EEDBA5Eull;
+    return config;
+}
+
+// Neighbor queries against populations of increasing density
+void benchNeighborQuery() {
+    for (int population : {500, 2000, 8000}) {
+        SimulationConfig config = baseConfig();
+        config.initialPrey = population;
+        config.NR = population;
+        SimulationController controller(config);
+        controller.initialize();
+        Grid& grid = controller.getGrid();
+
+        const size_t queries = 200000;
+        CounterRNG rng(config.rngSeed, 99);
+        std::vector<AgentHandle> buffer;
+        size_t found = 0;
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < queries; ++i) {
+            Position pos{rng.uniform01(), rng.uniform01()};
+            grid.getNearbyAgents(pos, config.interactionRadius, buffer);
+            found += buffer.size();
+        }
+        double ms = elapsedMs(start);
+        report("neighbor_query", "agents_" + std::to_string(population), queries, ms);
+        if (found == 0) {
+            std::cerr << "warning: neighbor_query found no agents\n";
+        }
+    }
+}
+
+// Insert/remove churn through the store, containers and spatial index
+void benchInsertRemoveChurn() {
+    SimulationConfig config = baseConfig();
+    SimulationContext context(config);
+    Grid grid(config.cellSize);
+
+    const size_t rounds = 50000;
+    CounterRNG rng(config.rngSeed, 7);
+    AgentPool pool;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < rounds; ++i) {
+        Position pos{rng.uniform01(), rng.uniform01()};
+        auto agent = pool.makePrey(pos, context);
+        grid.addAgent(agent);
+        grid.removeAgent(agent);
+    }
+    double ms = elapsedMs(start);
+    report("insert_remove_churn", "add_remove_pair", rounds, ms);
+}
+
+// The full reference simulation, sequential and parallel stepping
+void benchReferenceSimulation() {
+    for (bool parallel : {false, true}) {
+        SimulationConfig config = baseConfig();
+        config.parallelStepping = parallel;
+        SimulationController controller(config);
+        controller.initialize();
+
+        auto start = Clock::now();
+        controller.runForTimesteps(config.simulationSteps);
+        double ms = elapsedMs(start);
+        controller.end();
+        report("reference_sim_1000_steps", parallel ? "parallel" : "sequential",
+               static_cast<size_t>(config.simulationSteps), ms);
+    }
+}
+
+// A small LHS sweep over the dynamics parameters, as parameter_sweep runs it
+void benchSmallSweep() {
+    std::vector<LHSSampler::ParameterRange> ranges = {
+        {100.0, 1000.0},  // NR
+        {0.0, 1.0},       // DR
+        {0.0, 1.0},       // DF
+        {0.0, 1.0}        // RF
+    };
+    const int samples = 8;
+    const int steps = 200;
+    LHSSampler sampler(ranges, samples);
+    auto sampleValues = sampler.generateAllSamples();
+
+    auto start = Clock::now();
+    for (const auto& values : sampleValues) {
+        SimulationConfig config = baseConfig();
+        config.NR = static_cast<int>(values[0]);
+        config.DR = values[1];
+        config.DF = values[2];
+        config.RF = values[3];
+        config.simulationSteps = steps;
+        SimulationController controller(config);
+        controller.initialize();
+        controller.runForTimesteps(steps);
+        controller.end();
+    }
+    double ms = elapsedMs(start);
+    report("lhs_sweep", "samples_8_steps_200", static_cast<size_t>(samples), ms);
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "benchmark,variant,iterations,total_ms,per_op_us,ops_per_sec\n";
+    benchNeighborQuery();
+    benchInsertRemoveChurn();
+    benchReferenceSimulation();
+    benchSmallSweep();
+    return 0;
+}
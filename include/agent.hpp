@@ -24,6 +24,7 @@ protected:
     bool alive;
     SimulationContext& context;
     size_t id;  // Unique identifier for each agent
+    AgentHandle handle = InvalidAgentHandle;  // Slot in the AgentStore, set by Grid
 
 public:
     Agent(Type t, Position pos, SimulationContext& ctx, size_t agentId)
@@ -45,6 +46,8 @@ public:
     void setPosition(const Position& pos) { position = pos; } // Add this method to update position
     Type getType() const { return type; }
     size_t getId() const { return id; }
+    AgentHandle getHandle() const { return handle; }
+    void setHandle(AgentHandle h) { handle = h; }
     void die() { alive = false; }
 
     // Add an overload for shared_ptr
@@ -60,7 +63,9 @@ public:
     }
     
     static int getNextId();
+    static int peekIdCounter();
     static void resetIdCounter();
+    static void setIdCounter(int value);
 
 
 private:
@@ -84,3 +89,58 @@ public:
         : Agent(PREY, pos, ctx, Agent::getNextId()) {}
     AgentAction::Action getAction(bool hasInteraction) const override;
 };
+
+/**
+ * Compile-time per-type stepping policy. The virtual getAction overrides
+ * forward here, so the polymorphic path and the monomorphic stepAgents
+ * kernels in SimulationController share a single definition — but the
+ * kernels see through the static type and inline it, with the movement
+ * magnitude and rate parameters hoisted out of the per-agent loop.
+ * Draw order matches the historical getAction bodies exactly.
+ */
+template <typename AgentType>
+struct AgentTraits;
+
+template <>
+struct AgentTraits<Predator> {
+    static constexpr Agent::Type type = Agent::PREDATOR;
+
+    static double moveMagnitude(const SimulationConfig& config) { return config.MF; }
+
+    static AgentAction::Action decide(bool hasInteraction, CounterRNG& rng,
+                                      const SimulationConfig& config, int /*preyCount*/) {
+        if (hasInteraction) {
+            // Try to reproduce after a successful hunt
+            if (rng.uniform01() < config.RF) {
+                return AgentAction::Action::REPRODUCE;
+            }
+        } else {
+            // Risk of death when no prey around
+            if (rng.uniform01() < config.DF) {
+                return AgentAction::Action::DIE;
+            }
+        }
+        return AgentAction::Action::NOTHING;
+    }
+};
+
+template <>
+struct AgentTraits<Prey> {
+    static constexpr Agent::Type type = Agent::PREY;
+
+    static double moveMagnitude(const SimulationConfig& config) { return config.MR; }
+
+    static AgentAction::Action decide(bool hasInteraction, CounterRNG& rng,
+                                      const SimulationConfig& config, int preyCount) {
+        // Risk of being eaten
+        if (hasInteraction && rng.uniform01() < config.DR) {
+            return AgentAction::Action::DIE;
+        }
+        // Try to reproduce, throttled by the carrying capacity
+        if (rng.uniform01() <
+            config.RR * (1 - static_cast<double>(preyCount) / static_cast<double>(config.NR))) {
+            return AgentAction::Action::REPRODUCE;
+        }
+        return AgentAction::Action::NOTHING;
+    }
+};
@@ -1,75 +1,81 @@
 #pragma once
 
+#include "forward_decls.hpp"
 #include <vector>
-#include <memory>
 #include <unordered_map>
 #include <algorithm>
 
-// A cache-friendly container for storing agents with O(1) access, insertion, and removal
+// A cache-friendly container for storing agent handles with O(1) access,
+// insertion, and removal. Handles are 32-bit slots into the AgentStore,
+// so iteration touches a quarter of the memory shared_ptrs would.
+// The template parameter keeps predator and prey containers distinct types.
 template <typename AgentType>
 class AgentContainer {
 private:
-    // Main vector of agents
-    std::vector<std::shared_ptr<AgentType>> agents;
+    // Main vector of agent handles
+    std::vector<AgentHandle> handles;
     // Mapping of agent ID to index for O(1) lookup
     std::unordered_map<size_t, size_t> idToIndex;
+    // Mapping of index back to agent ID for swap-and-pop bookkeeping
+    std::vector<size_t> indexToId;
 
 public:
     // Default constructor
     AgentContainer() = default;
-    
+
     // O(1) access by index
-    std::shared_ptr<AgentType> get(size_t index) const {
-        return index < agents.size() ? agents[index] : nullptr;
+    AgentHandle get(size_t index) const {
+        return index < handles.size() ? handles[index] : InvalidAgentHandle;
     }
-    
+
     // O(1) access by ID
-    std::shared_ptr<AgentType> getById(size_t id) const {
+    AgentHandle getById(size_t id) const {
         auto it = idToIndex.find(id);
-        return (it != idToIndex.end()) ? agents[it->second] : nullptr;
+        return (it != idToIndex.end()) ? handles[it->second] : InvalidAgentHandle;
     }
-    
+
     // O(1) insertion
-    void add(std::shared_ptr<AgentType> agent) {
-        idToIndex[agent->getId()] = agents.size();
-        agents.emplace_back(std::move(agent));
+    void add(size_t id, AgentHandle handle) {
+        idToIndex[id] = handles.size();
+        indexToId.push_back(id);
+        handles.push_back(handle);
     }
-    
+
     // O(1) removal with swap-and-pop
     bool remove(size_t id) {
         auto it = idToIndex.find(id);
         if (it == idToIndex.end()) return false;
-        
+
         size_t index = it->second;
-        size_t lastIndex = agents.size() - 1;
-        
+        size_t lastIndex = handles.size() - 1;
+
         // If not the last element, swap with the last one
         if (index != lastIndex) {
-            std::swap(agents[index], agents[lastIndex]);
+            std::swap(handles[index], handles[lastIndex]);
+            std::swap(indexToId[index], indexToId[lastIndex]);
             // Update the moved agent's index
-            idToIndex[agents[index]->getId()] = index;
+            idToIndex[indexToId[index]] = index;
         }
-        
+
         // Remove the last element
-        agents.pop_back();
+        handles.pop_back();
+        indexToId.pop_back();
         idToIndex.erase(it);
         return true;
     }
-    
+
     // Fast iteration
-    const std::vector<std::shared_ptr<AgentType>>& getAll() const {
-        return agents;
+    const std::vector<AgentHandle>& getAll() const {
+        return handles;
     }
-    
+
     // Vector-like operations
-    size_t size() const { return agents.size(); }
-    bool empty() const { return agents.empty(); }
-    void clear() { agents.clear(); idToIndex.clear(); }
-    void reserve(size_t capacity) { agents.reserve(capacity); }
+    size_t size() const { return handles.size(); }
+    bool empty() const { return handles.empty(); }
+    void clear() { handles.clear(); idToIndex.clear(); indexToId.clear(); }
+    void reserve(size_t capacity) { handles.reserve(capacity); indexToId.reserve(capacity); }
 
     // Iterator access for range-based for loops
-    typename std::vector<std::shared_ptr<AgentType>>::iterator begin() { return agents.begin(); }
-    typename std::vector<std::shared_ptr<AgentType>>::iterator end() { return agents.end(); }
-    typename std::vector<std::shared_ptr<AgentType>>::const_iterator begin() const { return agents.begin(); }
-    typename std::vector<std::shared_ptr<AgentType>>::const_iterator end() const { return agents.end(); }
-};
\ No newline at end of file
+    std::vector<AgentHandle>::const_iterator begin() const { return handles.begin(); }
+    std::vector<AgentHandle>::const_iterator end() const { return handles.end(); }
+};
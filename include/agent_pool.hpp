@@ -0,0 +1,112 @@
+#pragma once
+
+#include "agent.hpp"
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * Slab arena with per-size free lists for recycling agent allocations.
+ * Reproduction and death in oscillating regimes churn through tens of
+ * thousands of agents per run; routing them through allocate_shared with
+ * this arena means the object and its control block come out of (and go
+ * back to) a free list, so steady-state stepping never touches malloc.
+ * One arena belongs to one simulation; it is not thread-safe.
+ */
+class PoolArena {
+private:
+    // Free blocks, grouped by block size (only a couple of sizes occur)
+    std::unordered_map<size_t, std::vector<void*>> freeLists;
+    // Backing slabs, released when the arena is destroyed
+    std::vector<std::unique_ptr<unsigned char[]>> slabs;
+
+    static constexpr size_t kSlabObjects = 1024;
+
+public:
+    PoolArena() = default;
+    PoolArena(const PoolArena&) = delete;
+    PoolArena& operator=(const PoolArena&) = delete;
+
+    void* allocate(size_t bytes) {
+        auto& freeList = freeLists[bytes];
+        if (freeList.empty()) {
+            // Carve a fresh slab into fixed-size blocks
+            auto slab = std::make_unique<unsigned char[]>(bytes * kSlabObjects);
+            unsigned char* base = slab.get();
+            freeList.reserve(freeList.size() + kSlabObjects);
+            for (size_t i = 0; i < kSlabObjects; ++i) {
+                freeList.push_back(base + i * bytes);
+            }
+            slabs.push_back(std::move(slab));
+        }
+        void* block = freeList.back();
+        freeList.pop_back();
+        return block;
+    }
+
+    void deallocate(void* block, size_t bytes) {
+        freeLists[bytes].push_back(block);
+    }
+};
+
+/**
+ * Minimal allocator adapter over PoolArena for std::allocate_shared.
+ * Single-object allocations (the only kind allocate_shared makes) are
+ * served from the arena; anything else falls through to operator new.
+ */
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolArena* arena;
+
+    explicit PoolAllocator(PoolArena& a) : arena(&a) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        if (n == 1) {
+            return static_cast<T*>(arena->allocate(sizeof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        if (n == 1) {
+            arena->deallocate(p, sizeof(T));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return arena == other.arena; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return arena != other.arena; }
+};
+
+/**
+ * Object pool for Predator and Prey creation.
+ * Used by SimulationController for both initial population setup and the
+ * reproduce path, so every agent of a simulation shares one arena.
+ */
+class AgentPool {
+private:
+    PoolArena arena;
+
+public:
+    template <typename... Args>
+    std::shared_ptr<Prey> makePrey(Args&&... args) {
+        return std::allocate_shared<Prey>(PoolAllocator<Prey>(arena),
+                                          std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::shared_ptr<Predator> makePredator(Args&&... args) {
+        return std::allocate_shared<Predator>(PoolAllocator<Predator>(arena),
+                                              std::forward<Args>(args)...);
+    }
+};
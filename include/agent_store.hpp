@@ -0,0 +1,187 @@
+#pragma once
+
+#include "agent.hpp"
+#include "forward_decls.hpp"
+#include "position.hpp"
+#include "quantized_position.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Structure-of-arrays backing store for all agents in a simulation.
+ * Coordinates, types and alive flags live in parallel contiguous arrays
+ * indexed by dense 32-bit handles, so the hot neighbor-scan loops read
+ * sequential memory instead of chasing shared_ptrs across the heap.
+ * The shared_ptr for each agent is kept alongside only for the
+ * object-oriented API at the boundary (getAction, reporting).
+ */
+class AgentStore {
+private:
+    // Parallel arrays indexed by handle
+    std::vector<double> xs;
+    std::vector<double> ys;
+    std::vector<uint8_t> types;
+    std::vector<uint8_t> aliveFlags;
+    std::vector<std::shared_ptr<Agent>> agents;
+
+    // Optional fixed-point coordinate mirror (see quantized_position.hpp),
+    // maintained at the same write points as xs/ys when enabled. Empty
+    // when off, so the hot write paths pay a single branch.
+    std::vector<uint32_t> qxs;
+    std::vector<uint32_t> qys;
+    bool quantized = false;
+
+    // Recycled slots from removed agents
+    std::vector<AgentHandle> freeList;
+    size_t liveCount = 0;
+
+public:
+    AgentStore() = default;
+
+    /**
+     * Adds an agent to the store, reusing a free slot when available.
+     *
+     * @param agent The agent to add
+     * @return The handle of the agent's slot
+     */
+    AgentHandle add(const std::shared_ptr<Agent>& agent) {
+        AgentHandle handle;
+        const Position pos = agent->getPosition();
+        if (!freeList.empty()) {
+            handle = freeList.back();
+            freeList.pop_back();
+            xs[handle] = pos.x;
+            ys[handle] = pos.y;
+            types[handle] = static_cast<uint8_t>(agent->getType());
+            aliveFlags[handle] = 1;
+            agents[handle] = agent;
+        } else {
+            handle = static_cast<AgentHandle>(xs.size());
+            xs.push_back(pos.x);
+            ys.push_back(pos.y);
+            types.push_back(static_cast<uint8_t>(agent->getType()));
+            aliveFlags.push_back(1);
+            agents.push_back(agent);
+            if (quantized) {
+                qxs.push_back(0);
+                qys.push_back(0);
+            }
+        }
+        if (quantized) {
+            qxs[handle] = quantized::fromUnit(pos.x);
+            qys[handle] = quantized::fromUnit(pos.y);
+        }
+        ++liveCount;
+        return handle;
+    }
+
+    /**
+     * Removes an agent from the store and recycles its slot.
+     *
+     * @param handle The handle of the agent to remove
+     */
+    void remove(AgentHandle handle) {
+        if (handle >= xs.size() || !aliveFlags[handle]) return;
+        aliveFlags[handle] = 0;
+        agents[handle].reset();
+        freeList.push_back(handle);
+        --liveCount;
+    }
+
+    /**
+     * Updates an agent's coordinates in the parallel arrays.
+     *
+     * @param handle The agent's handle
+     * @param pos The new position
+     */
+    void setPosition(AgentHandle handle, const Position& pos) {
+        xs[handle] = pos.x;
+        ys[handle] = pos.y;
+        if (quantized) {
+            qxs[handle] = quantized::fromUnit(pos.x);
+            qys[handle] = quantized::fromUnit(pos.y);
+        }
+    }
+
+    /**
+     * Enables or disables the fixed-point coordinate mirror. Enabling
+     * (re)quantizes every existing slot; disabling frees the arrays.
+     *
+     * @param enabled Whether to maintain quantized coordinates
+     */
+    void setQuantizedMirror(bool enabled) {
+        quantized = enabled;
+        if (enabled) {
+            qxs.resize(xs.size());
+            qys.resize(ys.size());
+            for (size_t i = 0; i < xs.size(); ++i) {
+                qxs[i] = quantized::fromUnit(xs[i]);
+                qys[i] = quantized::fromUnit(ys[i]);
+            }
+        } else {
+            qxs.clear();
+            qxs.shrink_to_fit();
+            qys.clear();
+            qys.shrink_to_fit();
+        }
+    }
+
+    bool hasQuantizedMirror() const { return quantized; }
+
+    // Hot-path accessors: plain array reads, no indirection
+    double x(AgentHandle handle) const { return xs[handle]; }
+    double y(AgentHandle handle) const { return ys[handle]; }
+    Agent::Type type(AgentHandle handle) const {
+        return static_cast<Agent::Type>(types[handle]);
+    }
+    bool isAlive(AgentHandle handle) const { return aliveFlags[handle] != 0; }
+    Position position(AgentHandle handle) const {
+        return Position(xs[handle], ys[handle]);
+    }
+
+    // Raw array access for batched kernels
+    const double* xData() const { return xs.data(); }
+    const double* yData() const { return ys.data(); }
+    // Quantized mirrors; only valid while the mirror is enabled
+    const uint32_t* qxData() const { return qxs.data(); }
+    const uint32_t* qyData() const { return qys.data(); }
+    const uint8_t* typeData() const { return types.data(); }
+    const uint8_t* aliveData() const { return aliveFlags.data(); }
+
+    /**
+     * Gets the agent object for a handle.
+     *
+     * @param handle The agent's handle
+     * @return The agent, or nullptr for a freed slot
+     */
+    std::shared_ptr<Agent> get(AgentHandle handle) const {
+        return handle < agents.size() ? agents[handle] : nullptr;
+    }
+
+    // Number of live agents
+    size_t size() const { return liveCount; }
+
+    // Number of slots (live + freed); handles are always below this
+    size_t capacity() const { return xs.size(); }
+
+    void reserve(size_t n) {
+        xs.reserve(n);
+        ys.reserve(n);
+        types.reserve(n);
+        aliveFlags.reserve(n);
+        agents.reserve(n);
+    }
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+        qxs.clear();
+        qys.clear();
+        types.clear();
+        aliveFlags.clear();
+        agents.clear();
+        freeList.clear();
+        liveCount = 0;
+    }
+};
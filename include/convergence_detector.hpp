@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Windowed steady-state detector over the per-step population histories.
+ * A run is considered converged once, after a configurable burn-in, the
+ * mean and standard deviation of the two halves of the trailing window
+ * agree within a relative tolerance for both populations. Sweeps use it
+ * to stop simulations as soon as the statistics have stabilized instead
+ * of burning the full configured step budget.
+ */
+class ConvergenceDetector {
+public:
+    struct WindowStats {
+        double mean;
+        double stddev;
+    };
+
+    /**
+     * @param burnIn Steps ignored at the start of the run
+     * @param window Trailing window length used for the stability test
+     * @param tolerance Max relative drift between window halves
+     */
+    ConvergenceDetector(int burnIn, int window, double tolerance)
+        : burnIn(burnIn), window(window), tolerance(tolerance) {}
+
+    /**
+     * Whether the stability test is due at this step. Checks are spaced
+     * half a window apart so detection cost stays amortized.
+     *
+     * @param currentStep The current timestep
+     * @return True if converged() should be evaluated now
+     */
+    bool shouldCheck(int currentStep) const {
+        int stride = std::max(1, window / 2);
+        return currentStep >= burnIn + window && currentStep % stride == 0;
+    }
+
+    /**
+     * Tests both histories for stabilized statistics over the trailing
+     * window.
+     *
+     * @param predatorHistory Per-step predator counts
+     * @param preyHistory Per-step prey counts
+     * @return True if both populations pass the stability test
+     */
+    bool converged(const std::vector<int>& predatorHistory,
+                   const std::vector<int>& preyHistory) const {
+        return stable(predatorHistory) && stable(preyHistory);
+    }
+
+    /**
+     * Mean and standard deviation over the trailing window of a history.
+     *
+     * @param history Per-step population counts
+     * @param window Window length; clipped to the history size
+     * @return The window statistics, or zeros for an empty history
+     */
+    static WindowStats windowStats(const std::vector<int>& history, int window) {
+        if (history.empty()) return {0.0, 0.0};
+        size_t count = std::min(history.size(), static_cast<size_t>(std::max(window, 1)));
+        size_t begin = history.size() - count;
+        double sum = 0.0;
+        for (size_t i = begin; i < history.size(); ++i) sum += history[i];
+        double mean = sum / static_cast<double>(count);
+        double sq = 0.0;
+        for (size_t i = begin; i < history.size(); ++i) {
+            double d = history[i] - mean;
+            sq += d * d;
+        }
+        double stddev = count > 1 ? std::sqrt(sq / static_cast<double>(count - 1)) : 0.0;
+        return {mean, stddev};
+    }
+
+private:
+    // One population passes if the two halves of the trailing window
+    // have means and spreads that agree within tolerance
+    bool stable(const std::vector<int>& history) const {
+        if (history.size() < static_cast<size_t>(window)) return false;
+        size_t half = static_cast<size_t>(window) / 2;
+        std::vector<int> older(history.end() - window, history.end() - half);
+        std::vector<int> newer(history.end() - half, history.end());
+        WindowStats a = windowStats(older, static_cast<int>(older.size()));
+        WindowStats b = windowStats(newer, static_cast<int>(newer.size()));
+
+        double meanScale = std::max(1.0, std::max(std::abs(a.mean), std::abs(b.mean)));
+        double stdScale = std::max(1.0, std::max(a.stddev, b.stddev));
+        return std::abs(a.mean - b.mean) <= tolerance * meanScale &&
+               std::abs(a.stddev - b.stddev) <= tolerance * stdScale;
+    }
+
+    int burnIn;
+    int window;
+    double tolerance;
+};
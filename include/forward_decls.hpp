@@ -1,6 +1,13 @@
 #pragma once
 
+#include <cstdint>
+
 // Forward declarations
 class Grid;
 class Agent;
-class SimulationContext; 
\ No newline at end of file
+class AgentStore;
+class SimulationContext;
+
+// Dense 32-bit index of an agent's slot in the AgentStore
+using AgentHandle = std::uint32_t;
+constexpr AgentHandle InvalidAgentHandle = UINT32_MAX;
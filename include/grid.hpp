@@ -2,30 +2,72 @@
 
 #include "agent.hpp"
 #include "agent_container.hpp"
+#include "agent_store.hpp"
 #include "spatial_grid.hpp"
 #include "position.hpp"
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 /**
  * Optimized grid class for efficient agent management and spatial queries.
- * This implementation uses type-specific containers and spatial partitioning
- * to achieve O(1) insertion, removal, and neighbor queries.
+ * Agent data lives in a structure-of-arrays AgentStore addressed by dense
+ * 32-bit handles; the type-specific containers and the spatial index hold
+ * handles only, keeping the hot query loops on contiguous memory.
  */
 class Grid {
 private:
+    // Structure-of-arrays agent data, addressed by handle
+    AgentStore store;
+
     // Typed containers for fast type-specific operations
     AgentContainer<Predator> predators;
     AgentContainer<Prey> preys;
-    
+
     // Spatial indexing
     SpatialGrid spatialGrid;
-    
+
+    // Per-agent interaction-check cooldowns for sparse stepping, indexed
+    // by handle. A nonzero entry means a clearance probe proved no
+    // opposite-type agent can close to within the interaction radius for
+    // that many more steps, so the agent's neighbor queries can be
+    // skipped. Slots are zeroed on (re)use in addAgent.
+    std::vector<uint16_t> interactionCooldowns;
+
+    // Persistent iteration order over all agents, shuffled in place each
+    // step instead of rebuilding and copying the population
+    std::vector<AgentHandle> iterationOrder;
+    std::vector<uint32_t> orderIndex;  // handle -> canonical slot in iterationOrder
+    bool orderDirty = false;           // set by removals; triggers compaction
+
+    // Pending batch changes, queued by tile workers during a parallel
+    // phase and applied on the main thread between phases
+    std::vector<std::shared_ptr<Agent>> pendingAdditions;
+    std::vector<std::shared_ptr<Agent>> pendingRemovals;
+    std::vector<std::pair<std::shared_ptr<Agent>, Position>> pendingMoves;
+    std::mutex pendingMutex;
+
     // Cache-aligned fields to avoid false sharing in multithreaded contexts
     alignas(64) double cellSize;
     alignas(64) double worldWidth;
     alignas(64) double worldHeight;
 
+    // Drops dead and superseded entries from the iteration order in place
+    void compactIterationOrder() {
+        size_t keep = 0;
+        for (size_t i = 0; i < iterationOrder.size(); ++i) {
+            AgentHandle handle = iterationOrder[i];
+            if (orderIndex[handle] == i && store.isAlive(handle)) {
+                iterationOrder[keep] = handle;
+                orderIndex[handle] = static_cast<uint32_t>(keep);
+                ++keep;
+            }
+        }
+        iterationOrder.resize(keep);
+        orderDirty = false;
+    }
+
 public:
     /**
      * Constructor initializes the grid with the given dimensions and cell size.
@@ -79,20 +121,105 @@ public:
      * This is more efficient than performing individual updates.
      */
     void applyPendingChanges();
-    
+
     /**
-     * Gets all predators in the simulation.
-     * 
-     * @return A const reference to the predator container
+     * Commits a whole step's moves in one pass for the batched stepping
+     * pipeline: agent objects and store coordinates are written first,
+     * then the spatial index is updated — with a single counting-sort
+     * rebuild when rebuild mode is on, per-handle rebucketing otherwise.
+     *
+     * @param handles The moved agents' handles
+     * @param newPositions Parallel array of their new positions
+     */
+    void applyMoves(const std::vector<AgentHandle>& handles,
+                    const std::vector<Position>& newPositions);
+
+    /**
+     * Answers the opposite-type interaction test for every live agent in
+     * one pass, sharing neighborhood gathering between agents per cell.
+     *
+     * @param radius The interaction radius
+     * @param flags Output, indexed by handle; see SpatialGrid
      */
-    const std::vector<std::shared_ptr<Predator>>& getPredators() const;
+    void computeInteractionFlags(double radius, std::vector<uint8_t>& flags) const {
+        spatialGrid.computeInteractionFlags(radius, flags);
+    }
     
     /**
-     * Gets all prey in the simulation.
-     * 
-     * @return A const reference to the prey container
+     * Gets the handles of all predators in the simulation.
+     *
+     * @return A const reference to the predator handle list
      */
-    const std::vector<std::shared_ptr<Prey>>& getPreys() const;
+    const std::vector<AgentHandle>& getPredators() const;
+
+    /**
+     * Gets the handles of all prey in the simulation.
+     *
+     * @return A const reference to the prey handle list
+     */
+    const std::vector<AgentHandle>& getPreys() const;
+
+    /**
+     * Gets the structure-of-arrays agent store backing the grid.
+     *
+     * @return A const reference to the agent store
+     */
+    const AgentStore& getStore() const { return store; }
+
+    /**
+     * Visits every agent once in a freshly shuffled order, reusing the
+     * persistent handle array instead of materializing agent vectors.
+     * Agents born during the pass are appended past the visited range and
+     * first updated next step; agents that die during the pass are skipped.
+     *
+     * @param rng The random generator used for the in-place shuffle
+     * @param fn Callback taking std::shared_ptr<Agent>; return false to stop early
+     */
+    template <typename RNG, typename Fn>
+    void forEachAgentShuffled(RNG& rng, Fn&& fn) {
+        shuffleIterationOrder(rng);
+        forEachAgentInOrder(std::forward<Fn>(fn));
+    }
+
+    /**
+     * The shuffle half of forEachAgentShuffled: compacts and reshuffles
+     * the persistent iteration order. Split out so callers can account
+     * for the shuffle separately from the agent updates.
+     *
+     * @param rng The random generator used for the in-place shuffle
+     */
+    template <typename RNG>
+    void shuffleIterationOrder(RNG& rng) {
+        if (orderDirty) {
+            compactIterationOrder();
+        }
+        std::shuffle(iterationOrder.begin(), iterationOrder.end(), rng);
+        // Restore the handle -> slot mapping after the shuffle
+        for (size_t i = 0; i < iterationOrder.size(); ++i) {
+            orderIndex[iterationOrder[i]] = static_cast<uint32_t>(i);
+        }
+    }
+
+    /**
+     * The visiting half of forEachAgentShuffled: walks the iteration
+     * order as last shuffled, with the same birth/death semantics.
+     *
+     * @param fn Callback taking std::shared_ptr<Agent>; return false to stop early
+     */
+    template <typename Fn>
+    void forEachAgentInOrder(Fn&& fn) {
+        // Births during the pass append past count and are not visited;
+        // a recycled slot fails the canonical-index check below
+        const size_t count = iterationOrder.size();
+        for (size_t i = 0; i < count; ++i) {
+            AgentHandle handle = iterationOrder[i];
+            if (orderIndex[handle] == i && store.isAlive(handle)) {
+                if (!fn(store.get(handle))) {
+                    break;
+                }
+            }
+        }
+    }
     
     /**
      * Gets all agents in the simulation.
@@ -110,7 +237,112 @@ public:
      * @return True if an opposite-type neighbor exists, false otherwise
      */
     bool hasOppositeTypeNeighbor(const std::shared_ptr<Agent>& agent, double radius);
-    
+
+    /**
+     * Checks for opposite-type neighbors around an explicit position, for
+     * agents whose move has not yet been committed to the spatial grid.
+     *
+     * @param agent The agent to check
+     * @param pos The position to search around
+     * @param radius The interaction radius
+     * @return True if an opposite-type neighbor exists, false otherwise
+     */
+    bool hasOppositeTypeNeighborAt(const std::shared_ptr<Agent>& agent,
+                                   const Position& pos, double radius);
+
+    // Tile partitioning support for the parallel stepping engine
+    int cellsWide() const { return spatialGrid.cellsWide(); }
+    int cellsHigh() const { return spatialGrid.cellsHigh(); }
+    const std::vector<AgentHandle>& cellAgents(int x, int y) const {
+        return spatialGrid.cellAgents(x, y);
+    }
+
+    /**
+     * Consumes one step of an agent's interaction cooldown, if any.
+     * While a cooldown runs, the caller may treat the agent's interaction
+     * test as false without querying: the clearance bound guarantees no
+     * opposite-type agent can yet be within the interaction radius.
+     *
+     * @param handle The agent's handle
+     * @return True if a cooldown was active and one step was consumed
+     */
+    bool consumeInteractionCooldown(AgentHandle handle) {
+        if (handle >= interactionCooldowns.size() ||
+            interactionCooldowns[handle] == 0) {
+            return false;
+        }
+        --interactionCooldowns[handle];
+        return true;
+    }
+
+    /**
+     * Starts an interaction cooldown after a successful clearance probe.
+     *
+     * @param handle The agent's handle
+     * @param steps Steps of neighbor queries the clearance bound covers
+     */
+    void setInteractionCooldown(AgentHandle handle, int steps) {
+        if (handle < interactionCooldowns.size() && steps > 0) {
+            interactionCooldowns[handle] = static_cast<uint16_t>(
+                std::min(steps, static_cast<int>(UINT16_MAX)));
+        }
+    }
+
+    /**
+     * Enables once-per-step counting-sort rebuilds of the spatial index
+     * instead of per-move cell maintenance. The controller must call
+     * rebuildSpatialIndex() at the top of each timestep while enabled.
+     * Not intended for use together with parallel stepping.
+     */
+    void setSpatialRebuildMode(bool enabled) { spatialGrid.setRebuildMode(enabled); }
+    bool spatialRebuildEnabled() const { return spatialGrid.isRebuildMode(); }
+
+    /**
+     * Enables the per-cell opposite-type candidate cache so co-located
+     * agents share neighbor summaries. Single-threaded queries only.
+     */
+    void setSummaryCache(bool enabled) { spatialGrid.setSummaryCache(enabled); }
+
+    /**
+     * Enables toroidal (periodic) boundaries in the spatial index; see
+     * SpatialGrid::setTorusMode. Only call between steps.
+     */
+    void setTorusMode(bool enabled) { spatialGrid.setTorusMode(enabled); }
+    bool isTorusMode() const { return spatialGrid.isTorusMode(); }
+
+    /**
+     * Enables fixed-point coordinates: the store maintains a uint32
+     * mirror of every position and the spatial index re-buckets onto
+     * power-of-two cells indexed by shift; see SpatialGrid. Only call
+     * between steps.
+     */
+    void setQuantizedPositions(bool enabled) {
+        store.setQuantizedMirror(enabled);
+        spatialGrid.setQuantizedCells(enabled);
+    }
+    bool isQuantizedPositions() const { return spatialGrid.isQuantizedCells(); }
+
+    // Rebuilds the CSR spatial index from the store's live slots
+    void rebuildSpatialIndex() { spatialGrid.rebuild(); }
+
+    /**
+     * Re-buckets the spatial index with a new cell size. Only call
+     * between steps; existing cellAgents() references are invalidated.
+     *
+     * @param newCellSize The cell edge length to re-bucket with
+     */
+    void setCellSize(double newCellSize) {
+        cellSize = newCellSize;
+        spatialGrid.reconfigure(newCellSize);
+    }
+
+    double getCellSize() const { return cellSize; }
+
+    // Occupancy histogram and query candidate/hit counters for tuning
+    SpatialGrid::OccupancyStats spatialStats() const { return spatialGrid.occupancyStats(); }
+    void resetSpatialQueryCounters() { spatialGrid.resetQueryCounters(); }
+
+
     /**
      * Gets all agents within the given radius of the position.
      * 
@@ -130,7 +362,41 @@ public:
      */
     std::vector<std::shared_ptr<Agent>> getNearbyAgentsOfType(
             const Position& pos, double radius, Agent::Type type);
-    
+
+    /**
+     * Fills a caller-provided buffer with handles of agents within the
+     * radius; reusing the buffer across calls avoids per-query allocation.
+     *
+     * @param pos The position to search around
+     * @param radius The search radius
+     * @param out Output buffer, cleared and filled with handles
+     */
+    void getNearbyAgents(const Position& pos, double radius, std::vector<AgentHandle>& out);
+
+    /**
+     * Type-filtered variant of the buffer-based neighbor query.
+     *
+     * @param pos The position to search around
+     * @param radius The search radius
+     * @param type The type of agents to find
+     * @param out Output buffer, cleared and filled with handles
+     */
+    void getNearbyAgentsOfType(const Position& pos, double radius, Agent::Type type,
+                               std::vector<AgentHandle>& out);
+
+    /**
+     * Visits each agent handle within the radius without allocating at all.
+     *
+     * @param pos The position to search around
+     * @param radius The search radius
+     * @param visit Callback taking an AgentHandle
+     */
+    template <typename Visitor>
+    void visitNearbyAgents(const Position& pos, double radius, Visitor&& visit) {
+        spatialGrid.visitNeighbors(pos, radius, std::forward<Visitor>(visit));
+    }
+
+
     /**
      * Updates an agent's position in the spatial grid.
      * For batch operations, use queueAgentMove instead.
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+// Lightweight hot-path instrumentation. The per-phase timers are
+// compiled out unless the build enables ENABLE_INSTRUMENTATION (which
+// defines PP_INSTRUMENTATION): the scoped timer bodies vanish and
+// StepMetrics collapses to an empty shell, so the default build pays
+// nothing. When enabled, the cost is two steady_clock reads per scope —
+// a few percent of a step, cheap enough for production sweeps.
+// The neighbor-query and cell-migration counters live in SpatialGrid
+// and are compiled out behind the same macro: even relaxed atomics
+// bounce cache lines between tile workers on every query.
+namespace instrumentation {
+
+enum Phase : int {
+    kShuffle = 0,
+    kMovement,
+    kMoveAgent,
+    kNeighborQuery,
+    kAction,
+    kBirthsDeaths,
+    kPhaseCount
+};
+
+inline const char* phaseName(int phase) {
+    static const char* const names[kPhaseCount] = {
+        "shuffle", "movement", "move_agent",
+        "neighbor_query", "action", "births_deaths"};
+    return names[phase];
+}
+
+// Spatial index counter snapshot for the report; all zeros in builds
+// without PP_INSTRUMENTATION
+struct QueryCounters {
+    uint64_t queries = 0;
+    uint64_t candidates = 0;  // gathered for distance testing
+    uint64_t hits = 0;        // actually within the radius
+    uint64_t cellMigrations = 0;
+};
+
+#ifdef PP_INSTRUMENTATION
+
+struct StepMetrics {
+    std::array<uint64_t, kPhaseCount> nanos{};
+    std::array<uint64_t, kPhaseCount> calls{};
+
+    static constexpr bool enabled() { return true; }
+    void reset() {
+        nanos.fill(0);
+        calls.fill(0);
+    }
+    void add(int phase, uint64_t ns) {
+        nanos[phase] += ns;
+        ++calls[phase];
+    }
+};
+
+// Accumulates the enclosing scope's wall time into one phase slot
+class ScopedTimer {
+public:
+    ScopedTimer(StepMetrics& metrics, int phase)
+        : metrics(metrics), phase(phase),
+          start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        metrics.add(phase, static_cast<uint64_t>(ns));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    StepMetrics& metrics;
+    int phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+#else  // !PP_INSTRUMENTATION
+
+struct StepMetrics {
+    static constexpr bool enabled() { return false; }
+    void reset() {}
+    void add(int, uint64_t) {}
+};
+
+class ScopedTimer {
+public:
+    ScopedTimer(StepMetrics&, int) {}
+};
+
+#endif  // PP_INSTRUMENTATION
+
+// Renders the metrics and counters as a JSON object; hand-rolled so the
+// core library stays free of heavier serialization dependencies
+inline std::string toJson(const StepMetrics& metrics, const QueryCounters& counters) {
+    std::ostringstream out;
+    out << "{\"timers_enabled\":" << (StepMetrics::enabled() ? "true" : "false");
+#ifdef PP_INSTRUMENTATION
+    out << ",\"phases\":{";
+    for (int phase = 0; phase < kPhaseCount; ++phase) {
+        if (phase > 0) out << ",";
+        out << "\"" << phaseName(phase) << "\":{\"nanos\":" << metrics.nanos[phase]
+            << ",\"calls\":" << metrics.calls[phase] << "}";
+    }
+    out << "}";
+#else
+    (void)metrics;
+#endif
+    out << ",\"spatial\":{\"queries\":" << counters.queries
+        << ",\"candidates\":" << counters.candidates
+        << ",\"hits\":" << counters.hits
+        << ",\"cell_migrations\":" << counters.cellMigrations << "}}";
+    return out.str();
+}
+
+}  // namespace instrumentation
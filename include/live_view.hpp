@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Lock-free single-producer/single-consumer frame ring for the live
+ * view. The simulation thread publishes population counts and a
+ * (possibly downsampled) agent snapshot per frame; a viewer consumes
+ * at its own rate. Neither side ever blocks: a producer that finds the
+ * ring full drops the frame, and a consumer always jumps to the newest
+ * committed frame, releasing everything older. Frame vectors live in
+ * the ring and keep their capacity, so steady-state publishing is a
+ * plain copy with no allocation.
+ *
+ * Exactly one producer and one consumer thread; the head/tail indices
+ * carry the only cross-thread ordering (release on publish, acquire on
+ * read), matching how the trajectory recorder hands buffers around.
+ */
+class LiveViewBuffer {
+public:
+    struct Frame {
+        uint32_t step = 0;
+        int predators = 0;
+        int prey = 0;
+        // Downsampled agent snapshot, parallel arrays; types hold the
+        // Agent::Type value per entry
+        std::vector<float> xs;
+        std::vector<float> ys;
+        std::vector<uint8_t> types;
+    };
+
+    explicit LiveViewBuffer(size_t capacity = 8)
+        : frames(roundUpPow2(capacity)), mask(frames.size() - 1) {}
+
+    LiveViewBuffer(const LiveViewBuffer&) = delete;
+    LiveViewBuffer& operator=(const LiveViewBuffer&) = delete;
+
+    // --- Producer side (simulation thread) ---
+
+    /**
+     * The slot for the next frame, or nullptr when the consumer is a
+     * full ring behind — the caller then skips this frame entirely, so
+     * a stalled viewer costs the simulation nothing.
+     */
+    Frame* beginWrite() {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) > mask) {
+            return nullptr;
+        }
+        return &frames[h & mask];
+    }
+
+    // Publishes the frame filled in after beginWrite()
+    void commitWrite() {
+        head.fetch_add(1, std::memory_order_release);
+    }
+
+    // --- Consumer side (viewer thread) ---
+
+    /**
+     * The newest committed frame, or nullptr when nothing new exists.
+     * The slot stays valid until releaseLatest(), which also discards
+     * every older frame — the consumer never renders stale backlog.
+     */
+    const Frame* acquireLatest() {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        if (tail.load(std::memory_order_relaxed) == h) {
+            return nullptr;
+        }
+        readCursor = h;
+        return &frames[(h - 1) & mask];
+    }
+
+    // Frees the acquired frame and everything older for reuse
+    void releaseLatest() {
+        tail.store(readCursor, std::memory_order_release);
+    }
+
+private:
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    std::vector<Frame> frames;
+    size_t mask;
+    uint64_t readCursor = 0;  // consumer-only
+    // Producer bumps head, consumer bumps tail; monotonic and wrapped
+    // with the mask, so fullness is a plain difference
+    std::atomic<uint64_t> head{0};
+    std::atomic<uint64_t> tail{0};
+};
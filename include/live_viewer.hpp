@@ -0,0 +1,60 @@
+#pragma once
+
+#include "live_view.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+/**
+ * Viewer side of the live view: renders frames from a LiveViewBuffer in
+ * an SFML window on its own thread, at its own frame rate. The viewer
+ * always draws the newest committed frame and re-draws the previous one
+ * when the simulation has not published since — it never backs up the
+ * producer, and never sees backlog. Implemented in the visualization
+ * target; headless builds link only predator_prey_core and must not use
+ * this class.
+ */
+class LiveViewer {
+public:
+    /**
+     * @param buffer The frame ring returned by
+     *               SimulationController::enableLiveView()
+     * @param frameRate Window frame-rate limit in frames per second
+     */
+    explicit LiveViewer(std::shared_ptr<LiveViewBuffer> buffer,
+                        unsigned int frameRate = 30);
+
+    // Joins the render thread if the window is still open
+    ~LiveViewer();
+
+    LiveViewer(const LiveViewer&) = delete;
+    LiveViewer& operator=(const LiveViewer&) = delete;
+
+    /**
+     * Opens the window and starts the render thread. No-op if already
+     * running.
+     */
+    void start();
+
+    /**
+     * Asks the render thread to close the window and joins it. Also
+     * called by the destructor; safe to call repeatedly.
+     */
+    void stop();
+
+    /**
+     * Whether the render thread is alive. Turns false on its own when
+     * the user closes the window.
+     *
+     * @return True while the viewer window is open
+     */
+    bool isOpen() const { return running.load(std::memory_order_relaxed); }
+
+private:
+    void renderLoop();
+
+    std::shared_ptr<LiveViewBuffer> buffer;
+    unsigned int frameRate;
+    std::thread renderThread;
+    std::atomic<bool> running{false};
+};
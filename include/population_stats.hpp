@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+/**
+ * Incremental population statistics: Welford running mean/variance plus
+ * min/max, updated in O(1) per observation. Run-level metrics can be
+ * read without rescanning the population histories.
+ */
+class PopulationStats {
+public:
+    void add(double value) {
+        ++n;
+        double delta = value - runningMean;
+        runningMean += delta / n;
+        m2 += delta * (value - runningMean);
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+    }
+
+    size_t count() const { return n; }
+    double mean() const { return n > 0 ? runningMean : 0.0; }
+
+    // Sample variance (n - 1 denominator), matching the sweep aggregator
+    double variance() const { return n > 1 ? m2 / (n - 1) : 0.0; }
+    double stddev() const { return std::sqrt(variance()); }
+
+    double minimum() const { return n > 0 ? minValue : 0.0; }
+    double maximum() const { return n > 0 ? maxValue : 0.0; }
+
+    void reset() { *this = PopulationStats(); }
+
+private:
+    size_t n = 0;
+    double runningMean = 0.0;
+    double m2 = 0.0;
+    double minValue = std::numeric_limits<double>::max();
+    double maxValue = std::numeric_limits<double>::lowest();
+};
+
+/**
+ * Fixed-capacity decimating series. Appends are O(1); when the buffer
+ * fills it drops every other retained sample and doubles the keep
+ * stride, so the retained samples always span the whole run on a
+ * uniform power-of-two grid — ready for FFT-style post-processing
+ * (oscillation period, cross-correlation) without storing full
+ * histories per replicate.
+ */
+class DownsampledSeries {
+public:
+    explicit DownsampledSeries(size_t capacity = 256)
+        : capacity(std::max<size_t>(capacity, 2)) {
+        retained.reserve(this->capacity);
+    }
+
+    void add(double value) {
+        size_t index = tick++;
+        if (index % keepStride != 0) {
+            return;
+        }
+        if (retained.size() == capacity) {
+            // Halve in place: the survivors are exactly the samples whose
+            // original index divides the doubled stride
+            size_t out = 0;
+            for (size_t i = 0; i < retained.size(); i += 2) {
+                retained[out++] = retained[i];
+            }
+            retained.resize(out);
+            keepStride *= 2;
+            if (index % keepStride != 0) {
+                return;
+            }
+        }
+        retained.push_back(value);
+    }
+
+    // Retained samples, one every stride() observations from the start
+    const std::vector<double>& samples() const { return retained; }
+    size_t stride() const { return keepStride; }
+    size_t observations() const { return tick; }
+
+    void reset() {
+        retained.clear();
+        keepStride = 1;
+        tick = 0;
+    }
+
+private:
+    size_t capacity;
+    size_t keepStride = 1;
+    size_t tick = 0;
+    std::vector<double> retained;
+};
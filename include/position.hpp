@@ -26,10 +26,36 @@ struct Position {
         );
     }
 
+    // Wraps a coordinate onto the unit torus; floor handles negative
+    // overshoot and values past 1 in the same branch-free expression
+    static double wrapUnit(double v) {
+        return v - std::floor(v);
+    }
+
+    // This position wrapped onto the unit torus, for the toroidal world mode
+    Position wrappedUnit() const {
+        return {wrapUnit(x), wrapUnit(y)};
+    }
+
+    // Signed minimum-image separation of two unit-torus coordinates
+    static double minImageDelta(double a, double b) {
+        double d = a - b;
+        if (d > 0.5) d -= 1.0;
+        else if (d < -0.5) d += 1.0;
+        return d;
+    }
+
     double distanceSquaredTo(const Position& other) const {
         return (x - other.x) * (x - other.x) + (y - other.y) * (y - other.y);
     }
 
+    // Minimum-image distance on the unit torus
+    double torusDistanceSquaredTo(const Position& other) const {
+        double dx = minImageDelta(x, other.x);
+        double dy = minImageDelta(y, other.y);
+        return dx * dx + dy * dy;
+    }
+
     double distanceTo(const Position& other) const {
         return std::sqrt(distanceSquaredTo(other));
     }   
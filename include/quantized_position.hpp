@@ -0,0 +1,73 @@
+#pragma once
+
+#include "position.hpp"
+#include <cstdint>
+
+/**
+ * Fixed-point coordinates for the unit world. A coordinate in [0,1] maps
+ * onto the full uint32 range, so one quantum is 2^-32 of the world —
+ * far below any physically meaningful distance in this model. With the
+ * cell grid rounded to a power of two per axis, the cell index becomes
+ * a single shift of the quantized coordinate instead of the divide and
+ * floor the double path pays, and distance comparisons run in integer
+ * arithmetic on half-width operands. Doubles remain the source of
+ * truth; quantized values are a derived mirror written at the same
+ * store boundary as the coordinates themselves.
+ */
+namespace quantized {
+
+// 2^32: the unit interval spans the full uint32 range
+constexpr double kScale = 4294967296.0;
+constexpr int kCoordBits = 32;
+
+// Quantizes a unit-world coordinate; the closed upper bound 1.0 lands on
+// the top quantum instead of wrapping
+inline uint32_t fromUnit(double v) {
+    double scaled = v * kScale;
+    if (scaled <= 0.0) return 0;
+    if (scaled >= kScale - 1.0) return UINT32_MAX;
+    return static_cast<uint32_t>(scaled);
+}
+
+// Mid-quantum reconstruction, so a round trip stays within half a quantum
+inline double toUnit(uint32_t q) {
+    return (static_cast<double>(q) + 0.5) / kScale;
+}
+
+// A radius in quanta, rounded up so the integer test never rejects a
+// pair the double test would accept
+inline uint64_t radiusQuanta(double r) {
+    return static_cast<uint64_t>(r * kScale) + 1;
+}
+
+inline uint64_t radiusSquaredQuanta(double r) {
+    const double s = r * kScale;
+    return static_cast<uint64_t>(s * s);
+}
+
+// Integer distance test with a per-axis early reject; keeping the axis
+// deltas at or below the radius also keeps the squares from overflowing
+inline bool withinRadius(uint32_t ax, uint32_t ay, uint32_t bx, uint32_t by,
+                         uint64_t qr, uint64_t qr2) {
+    const uint64_t dx = ax > bx ? ax - bx : bx - ax;
+    const uint64_t dy = ay > by ? ay - by : by - ay;
+    if (dx > qr || dy > qr) return false;
+    return dx * dx + dy * dy <= qr2;
+}
+
+// Value type for code that carries quantized coordinates around; the
+// hot paths read the store's raw mirror arrays instead
+struct QuantizedPosition {
+    uint32_t x;
+    uint32_t y;
+
+    static QuantizedPosition from(const Position& pos) {
+        return {fromUnit(pos.x), fromUnit(pos.y)};
+    }
+
+    Position toPosition() const {
+        return Position(toUnit(x), toUnit(y));
+    }
+};
+
+}  // namespace quantized
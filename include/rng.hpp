@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Counter-based random generator: a splitmix64 finalizer applied to a
+ * keyed, incrementing counter. State is two 64-bit words, draws are
+ * allocation-free, streams are cheap to derive, and a (seed, stream)
+ * pair fully determines the sequence, which makes runs reproducible
+ * from a single recorded seed. Satisfies UniformRandomBitGenerator, so
+ * it plugs into std::shuffle and the standard distributions.
+ */
+class CounterRNG {
+public:
+    using result_type = uint64_t;
+
+    CounterRNG() : CounterRNG(0, 0) {}
+
+    CounterRNG(uint64_t seed, uint64_t stream)
+        : key(mix(seed ^ mix(stream + kGolden))), counter(0) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        return mix(key + counter++ * kGolden);
+    }
+
+    // Uniform double in [0, 1) from the top 53 bits of one draw
+    double uniform01() {
+        return static_cast<double>(operator()() >> 11) * 0x1.0p-53;
+    }
+
+    // Derives an independent stream without advancing this generator
+    CounterRNG split(uint64_t stream) const {
+        CounterRNG derived;
+        derived.key = mix(key ^ mix(stream + 1));
+        derived.counter = 0;
+        return derived;
+    }
+
+    // Draw position, for checkpointing the generator state
+    uint64_t getCounter() const { return counter; }
+    void setCounter(uint64_t c) { counter = c; }
+
+private:
+    static constexpr uint64_t kGolden = 0x9E3779B97F4A7C15ull;
+
+    // splitmix64 finalizer
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t key;
+    uint64_t counter;
+};
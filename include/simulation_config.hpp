@@ -22,6 +22,79 @@ struct SimulationConfig {
     // Simulation parameters
     int simulationSteps;
     bool randomizeInitialPositions;
+
+    // Parallel stepping parameters
+    bool parallelStepping = false;  // Opt-in checkerboard-tiled multithreaded stepping
+    int stepThreads = 0;            // Worker threads for tiled stepping; 0 = hardware concurrency
+
+    // Batched stepping: movement, spatial update and interaction tests
+    // run as whole-population phases instead of interleaved per agent
+    bool batchedStepping = false;
+
+    // Typed stepping: two monomorphic per-type kernels (all prey, then
+    // all predators, each pass shuffled) with devirtualized actions and
+    // hoisted rate parameters, instead of the mixed-type shuffled loop
+    bool typedStepping = false;
+
+    // Sparse interaction checks: when an agent's neighbor query misses, a
+    // wider clearance probe runs; if no opposite-type agent exists within
+    // sparseClearanceRadius either, the agent skips its interaction
+    // checks for as many steps as the distance bound guarantees nothing
+    // can close to within interactionRadius (movement still applies
+    // every step, so the dynamics are unchanged). Pays off in low-density
+    // predator regimes; applies to the sequential and typed paths.
+    bool sparseInteractionChecks = false;
+    double sparseClearanceRadius = 0.0;  // Clearance probe radius; 0 = derive
+                                         // interactionRadius + 7*max(MF, MR)
+                                         // at initialize, covering three steps
+
+    // Toroidal world: positions wrap around instead of clamping to the
+    // walls, and neighbor queries see across the seam. Removes the
+    // edge-cell pileups the clamped world accumulates.
+    bool toroidalWorld = false;
+
+    // Spatial index parameters
+    bool spatialRebuild = false;    // Counting-sort rebuild of the spatial index once per step
+    bool autoTuneCellSize = false;  // Derive cellSize from interactionRadius and expected density
+
+    // Quantized positions: the store mirrors every coordinate as a
+    // uint32 fixed-point value, the cell grid rounds to a power of two
+    // per axis so cell indexing is a shift instead of a divide+floor,
+    // and the spiral neighbor query tests candidates in integer
+    // arithmetic. Distances quantize at 2^-32 of the world — far below
+    // any meaningful scale, but not bit-identical to the double path.
+    bool quantizedPositions = false;
+
+    // Random number generation
+    uint64_t rngSeed = 0;           // Base seed for all RNG streams; 0 = draw from random_device
+
+    // Trajectory recording parameters
+    bool recordTrajectory = false;  // Snapshot every agent position per step to a binary file
+    std::string trajectoryFile = "trajectory.bin";
+
+    // Checkpoint parameters
+    int checkpointInterval = 0;     // Steps between checkpoints; 0 = disabled
+    std::string checkpointFile = "checkpoint.bin";
+
+    // Mean-field fast path: once a run is absorbed (predators extinct,
+    // prey pinned at NR), step the population counts in closed form
+    // instead of the agents. Exact — the absorbed state has no exit and
+    // nothing stochastic left — so it stays on by default.
+    bool meanFieldFastPath = true;
+
+    // Decay regime of the fast path: with prey at capacity and predators
+    // starving, evolve the expected predator count deterministically
+    // instead of drawing per-predator deaths, probing periodically with
+    // a real agent step to catch exits. Approximate — it narrows the
+    // extinction-time distribution and replicate variance — so like the
+    // other behavior-changing modes it is opt-in.
+    bool meanFieldDecayApprox = false;
+
+    // Convergence detection parameters
+    bool earlyTermination = false;     // Stop stepping once windowed statistics stabilize
+    int convergenceBurnIn = 100;       // Steps ignored before testing for convergence
+    int convergenceWindow = 100;       // Trailing window length for the stability test
+    double convergenceTolerance = 0.05;  // Max relative drift between window halves
     
     // Population dynamics parameters
     int NR;    // Carrying capacity of Prey
@@ -1,31 +1,138 @@
 #pragma once
 
 #include "simulation_config.hpp"
+#include "rng.hpp"
+#include <atomic>
 #include <random>
 
 class SimulationContext {
 public:
     explicit SimulationContext(const SimulationConfig& cfg)
-    : config(cfg), predatorCount(0), preyCount(0), rng(std::random_device()()) {}
-    
+    : config(cfg), predatorCount(0), preyCount(0), seed(drawSeed(cfg)) {}
+
+    // The base seed a config asks for: its own when nonzero, otherwise a
+    // fresh one from random_device
+    static uint64_t drawSeed(const SimulationConfig& cfg) {
+        return cfg.rngSeed != 0
+                   ? cfg.rngSeed
+                   : (static_cast<uint64_t>(std::random_device{}()) << 32) ^
+                         std::random_device{}();
+    }
+
     // Prevent copying
     SimulationContext(const SimulationContext&) = delete;
     SimulationContext& operator=(const SimulationContext&) = delete;
-    
+
     // Allow moving
     // SimulationContext(SimulationContext&&) noexcept = default;
     // SimulationContext& operator=(SimulationContext&&) = delete;  // Cannot move references
-    
+
     const SimulationConfig& getConfig() const { return config; }
-    std::mt19937& getRNG() { return rng; }
+
+    // The seed all of this simulation's streams derive from
+    uint64_t getSeed() const { return seed; }
+
+    /**
+     * Rebinds the context to a fresh run with a new base seed: population
+     * counts go back to zero, the stream cursor restarts, and the epoch
+     * bump makes every thread's cached stream re-derive from the new seed
+     * on its next draw. Part of the controller's fast reset path.
+     *
+     * @param newSeed The base seed for the next run's streams
+     */
+    void reset(uint64_t newSeed) {
+        seed = newSeed;
+        predatorCount = 0;
+        preyCount = 0;
+        nextStream.store(0, std::memory_order_relaxed);
+        epoch.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    CounterRNG& getRNG() {
+        // Each (thread, context) pairing draws from its own split stream:
+        // a sequential run always uses stream 1, so it replays exactly
+        // from the seed, and parallel tile workers get contention-free
+        // streams of their own. The epoch check re-derives streams that
+        // survived a context reset.
+        ThreadStream& ts = threadStream();
+        const uint64_t currentEpoch = epoch.load(std::memory_order_relaxed);
+        if (ts.ownerNonce != nonce || ts.epoch != currentEpoch) {
+            ts.ownerNonce = nonce;
+            ts.epoch = currentEpoch;
+            ts.streamId = nextStream.fetch_add(1, std::memory_order_relaxed) + 1;
+            ts.rng = CounterRNG(seed, ts.streamId);
+        }
+        return ts.rng;
+    }
+
+    // Checkpoint support: the stream id and draw position of the calling
+    // thread's generator, and the stream allocation cursor
+    uint64_t getStreamId() {
+        getRNG();  // ensure this thread's stream is bound to this context
+        return threadStream().streamId;
+    }
+    uint64_t getNextStreamCursor() const {
+        return nextStream.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Restores the RNG state from a checkpoint. Rebinds the calling
+     * thread's stream to the saved (seed, stream, counter) triple so a
+     * sequential run continues with the identical draw sequence. Streams
+     * held by other threads are re-derived lazily from the restored seed.
+     *
+     * @param savedSeed The base seed recorded in the checkpoint
+     * @param streamId The saving thread's stream id
+     * @param counter The saving thread's draw position
+     * @param nextStreamCursor The stream allocation cursor at save time
+     */
+    void restoreRngState(uint64_t savedSeed, uint64_t streamId,
+                         uint64_t counter, uint64_t nextStreamCursor) {
+        seed = savedSeed;
+        nextStream.store(nextStreamCursor, std::memory_order_relaxed);
+        ThreadStream& ts = threadStream();
+        ts.ownerNonce = nonce;
+        ts.epoch = epoch.load(std::memory_order_relaxed);
+        ts.streamId = streamId;
+        ts.rng = CounterRNG(seed, streamId);
+        ts.rng.setCounter(counter);
+    }
+
     int getPredatorCount() const { return predatorCount; }
     int getPreyCount() const { return preyCount; }
     void setPredatorCount(int count) { predatorCount = count; }
     void setPreyCount(int count) { preyCount = count; }
-    
-private:    
+
+private:
+    // Per-thread RNG stream, bound to the context it last drew from.
+    // The binding is by nonce, not address: a new context constructed at
+    // a destroyed one's address (both at epoch 0) would otherwise pass
+    // the check and silently continue the stale stream's counter,
+    // breaking seeded reproducibility.
+    struct ThreadStream {
+        uint64_t ownerNonce = 0;
+        uint64_t epoch = 0;
+        uint64_t streamId = 0;
+        CounterRNG rng;
+    };
+
+    // Identity nonces are drawn from a process-wide counter and never
+    // reused, unlike addresses
+    static uint64_t nextNonce() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static ThreadStream& threadStream() {
+        static thread_local ThreadStream ts;
+        return ts;
+    }
+
     const SimulationConfig& config;
     int predatorCount;
     int preyCount;
-    std::mt19937 rng;
-}; 
\ No newline at end of file
+    uint64_t seed;
+    const uint64_t nonce = nextNonce();  // this context's unique identity
+    std::atomic<uint64_t> nextStream{0};
+    std::atomic<uint64_t> epoch{0};  // bumped by reset(); invalidates cached streams
+};
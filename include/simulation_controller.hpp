@@ -1,12 +1,19 @@
 #pragma once
 
 #include "simulation_context.hpp"
+#include "agent_pool.hpp"
 #include "grid.hpp"
+#include "thread_pool.hpp"
+#include "trajectory_recorder.hpp"
+#include "live_view.hpp"
+#include "population_stats.hpp"
+#include "instrumentation.hpp"
 #include "simulation_report.hpp"
 #include "simulation_config.hpp"
 #include "agent.hpp"
 #include <vector>
 #include <random>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <numeric>
@@ -18,14 +25,30 @@ struct SimulationStats {
     int preyCount;
 };
 
+// Per-phase state changes collected by tile workers and applied on the
+// main thread between checkerboard color phases
+struct TileStepChanges {
+    std::vector<std::pair<Agent::Type, Position>> births;
+    std::vector<std::shared_ptr<Agent>> deaths;
+};
+
 /**
  * Optimized SimulationController for managing the predator-prey simulation.
  * This version features improved data structures and batch processing.
  */
 class SimulationController {
 private:
+    // The controller's own copy of the configuration; the context holds a
+    // reference to it, so reset() can swap configs in place without
+    // re-seating anything
+    SimulationConfig configStorage;
+
     // Simulation context and configuration
     SimulationContext context;
+
+    // Recycling pool for agent allocations; declared before the grid so the
+    // arena outlives every shared_ptr the grid still holds on destruction
+    AgentPool agentPool;
     Grid grid;
     
     // Simulation state
@@ -38,6 +61,21 @@ private:
     // Population history tracking
     std::vector<int> predatorHistory;
     std::vector<int> preyHistory;
+
+    // Incremental per-run statistics, fed by updateHistory; replicate
+    // readers get run-level metrics without rescanning the histories
+    PopulationStats predatorStats;
+    PopulationStats preyStats;
+    DownsampledSeries predatorSeries;
+    DownsampledSeries preySeries;
+    int extinctionStep = -1;  // First step predators hit zero; -1 if never
+
+    // Per-phase hot-path timers; an empty shell unless the build enabled
+    // ENABLE_INSTRUMENTATION. Only the single-threaded stepping paths
+    // feed it — tile workers would race on the accumulators, so the
+    // parallel path is covered by the spatial counters alone (compiled
+    // in and out together with the timers).
+    instrumentation::StepMetrics stepMetrics;
     
     // Population counters
     int predatorCount;
@@ -45,20 +83,56 @@ private:
     
     // Helper methods
     void updateSingleTimestep();
+    void updateSingleTimestepParallel();
+    void updateSingleTimestepBatched();
+    void updateSingleTimestepTyped();
+    template <typename AgentType>
+    void stepAgents();
     void updateSingleAgent(std::shared_ptr<Agent> agent);
+    bool interactionCheck(const std::shared_ptr<Agent>& agent);
+    Position confinePosition(Position pos) const;
+    void updateAgentTiled(const std::shared_ptr<Agent>& agent, TileStepChanges& changes);
     void updateHistory();
     void initializePopulation();
-    
-    // Random distributions for movement and agent selection
-    std::uniform_real_distribution<double> positionDist;
-    std::uniform_real_distribution<double> directionDist;
+    void maybeRetuneCellSize();
+    void finalizeStep();
+    bool updateMeanField();
+    void noteStepInteractions();
 
-public:
-    // Static RNG (thread-safe)
-    static std::mt19937 rng;
-    static std::uniform_real_distribution<double> reproDist;
-    static std::uniform_real_distribution<double> deathDist;
+    // Mean-field fast path state (see updateMeanField). The interaction
+    // flag is atomic because tile workers set it concurrently.
+    bool meanFieldDecayActive = false;
+    int quietPredatorSteps = 0;
+    int meanFieldProbeCountdown = 0;
+    double meanFieldDeathDebt = 0.0;
+    std::atomic<bool> predatorInteractedThisStep{false};
+
+    // Worker pool for tiled stepping, created lazily when the config opts in
+    std::unique_ptr<ThreadPool> stepPool;
 
+    // Double-update guard for tiled stepping: the epoch of the last tiled
+    // step that updated each handle. Moves commit at every color-phase
+    // boundary, so an agent crossing into a later-colored tile would be
+    // visited again in the same timestep; the stamp makes that second
+    // visit a no-op. Newborns are stamped at birth so they first step
+    // next timestep, matching the sequential paths. Within a phase each
+    // handle lives in exactly one tile, so workers never touch the same
+    // entry concurrently, and the vector is only resized on the main
+    // thread between phases.
+    std::vector<uint32_t> tiledStepStamp;
+    uint32_t tiledStepEpoch = 0;
+
+    // Optional per-step trajectory recorder; null unless enabled
+    std::unique_ptr<TrajectoryRecorder> trajectoryRecorder;
+
+    // Optional live-view frame ring (see enableLiveView); null unless
+    // enabled. The controller is the single producer.
+    std::shared_ptr<LiveViewBuffer> liveViewBuffer;
+    int liveViewStride = 1;
+    int liveViewInterval = 1;
+    void publishLiveFrame();
+    
+public:
     /**
      * Constructor initializes the simulation with the given configuration.
      * 
@@ -70,7 +144,19 @@ public:
      * Initializes the simulation, setting up initial agent populations.
      */
     void initialize();
-    
+
+    /**
+     * Fast reinitialization for back-to-back runs: swaps in a new
+     * configuration and reinitializes, keeping every allocation the
+     * controller has grown — the spatial grid's cell vectors, the agent
+     * pool's slabs, the store's slots and the history capacity — so
+     * short replicates skip the construction cost entirely. A fresh base
+     * seed is drawn from the new config's rngSeed.
+     *
+     * @param config The configuration for the next run
+     */
+    void reset(const SimulationConfig& config);
+
     /**
      * Runs the simulation for a single timestep.
      */
@@ -186,7 +272,7 @@ public:
      * 
      * @return A random valid agent index
      */
-    size_t randomAgentIndex() const;
+    size_t randomAgentIndex();
     
     /**
      * Generates a random position within the world bounds.
@@ -203,12 +289,99 @@ public:
     Position randomDirection();
     
     /**
-     * Gets the final simulation report.
-     * 
+     * Writes the full simulation state to a binary checkpoint: agents
+     * (position, type, id, in update-iteration order), population
+     * histories, current step and RNG state. The image is assembled in
+     * memory and written with a single
+     * write followed by an atomic rename, so a kill mid-write never
+     * leaves a truncated checkpoint behind. Also written automatically
+     * every SimulationConfig::checkpointInterval steps when nonzero.
+     *
+     * @param path Path of the checkpoint file
+     */
+    void saveCheckpoint(const std::string& path);
+
+    /**
+     * Restores the simulation from a checkpoint written by
+     * saveCheckpoint(). For sequential runs the continuation is
+     * draw-for-draw identical to the uninterrupted run; parallel tile
+     * workers re-derive fresh streams from the restored seed.
+     *
+     * @param path Path of the checkpoint file
+     * @return True if the checkpoint was loaded, false if unreadable
+     */
+    bool loadCheckpoint(const std::string& path);
+
+    /**
+     * Enables binary trajectory recording to the given file.
+     * Must be called before initialize(); every subsequent step is
+     * snapshotted. See TrajectoryRecorder for the file layout.
+     *
+     * @param path Path of the trajectory file to create
+     */
+    void enableTrajectoryRecording(const std::string& path);
+
+    /**
+     * Enables the live view: every frameInterval-th step the controller
+     * publishes the population counts and every agentStride-th live
+     * agent's position into a lock-free SPSC frame ring. A viewer (see
+     * LiveViewer in the visualization target) renders from the returned
+     * buffer at its own frame rate; when it falls behind, frames are
+     * dropped rather than ever blocking the step loop, so the live view
+     * costs the simulation only the snapshot copy.
+     *
+     * @param agentStride Publish every Nth live agent (1 = all)
+     * @param frameInterval Steps between published frames
+     * @return The frame ring to hand to the viewer
+     */
+    std::shared_ptr<LiveViewBuffer> enableLiveView(int agentStride = 1,
+                                                   int frameInterval = 1);
+
+    /**
+     * Gets the final simulation report. The population histories are
+     * moved into the report, so call this once per run, after end();
+     * a subsequent initialize() starts fresh histories as always.
+     *
      * @return The simulation report
      */
-    SimulationReport getReport() const;
+    SimulationReport getReport();
     
+    /**
+     * Incremental statistics over the predator history, updated every
+     * step; O(1) to read regardless of run length.
+     *
+     * @return A const reference to the predator statistics accumulator
+     */
+    const PopulationStats& getPredatorStats() const { return predatorStats; }
+
+    /**
+     * Incremental statistics over the prey history; see getPredatorStats().
+     *
+     * @return A const reference to the prey statistics accumulator
+     */
+    const PopulationStats& getPreyStats() const { return preyStats; }
+
+    /**
+     * Whole-run downsampled predator series for spectral post-processing.
+     *
+     * @return A const reference to the decimated predator series
+     */
+    const DownsampledSeries& getPredatorSeries() const { return predatorSeries; }
+
+    /**
+     * Whole-run downsampled prey series; see getPredatorSeries().
+     *
+     * @return A const reference to the decimated prey series
+     */
+    const DownsampledSeries& getPreySeries() const { return preySeries; }
+
+    /**
+     * Gets the step at which predators first hit zero.
+     *
+     * @return The extinction step, or -1 if predators never went extinct
+     */
+    int getExtinctionStep() const { return extinctionStep; }
+
     /**
      * Gets the grid used by the simulation.
      * 
@@ -2,9 +2,11 @@
 
 #include <vector>
 #include <functional>
-#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <utility>
 #include "simulation_config.hpp"
 #include "simulation_context.hpp"
+#include "instrumentation.hpp"
 
 class SimulationReport {
 public:
@@ -15,36 +17,68 @@ public:
     // simulationConfig is the configuration used for the simulation
     // timeSteps is the number of time steps in the simulation
     // The constructor initializes the report with the given data
+    // Histories are taken by value and moved into place, so callers that
+    // no longer need theirs can hand them over without a copy
     SimulationReport(
-        const std::vector<int> predator_history,
-        const std::vector<int> prey_history,
+        std::vector<int> predator_history,
+        std::vector<int> prey_history,
         int finalPredatorCount,
         int finalPreyCount,
         const SimulationConfig& config,
         int timeSteps,
         std::chrono::milliseconds executionTime,
-        int normalizedPreyCount)
-        :   prey_history(prey_history),
-            predator_history(predator_history),
+        int normalizedPreyCount,
+        uint64_t rngSeed = 0)
+        :   prey_history(std::move(prey_history)),
+            predator_history(std::move(predator_history)),
             finalPredatorCount(finalPredatorCount),
             finalPreyCount(finalPreyCount),
             simulationConfig(config),
             timeSteps(timeSteps),
             executionTime(executionTime),
-            normalizedPreyCount(normalizedPreyCount) {}
+            normalizedPreyCount(normalizedPreyCount),
+            rngSeed(rngSeed) {}
     
+    // Opens an SFML window plotting the population histories. Implemented
+    // in the predator_prey_viz target; headless builds that link only
+    // predator_prey_core must not call this.
     void visualize();
+
     int getPreyCount() const { return finalPreyCount; }
     int getPredatorCount() const { return finalPredatorCount; }
     int getNormalizedPreyCount() const {return normalizedPreyCount;}
     
-    // Getters for history
-    std::vector<int> getPreyHistory() const { return prey_history; }
-    std::vector<int> getPredatorHistory() const { return predator_history; }
+    // Getters for history (const references; no per-call copies)
+    const std::vector<int>& getPreyHistory() const { return prey_history; }
+    const std::vector<int>& getPredatorHistory() const { return predator_history; }
 
-    SimulationConfig getSimulationConfig() const { return simulationConfig; }
+    const SimulationConfig& getSimulationConfig() const { return simulationConfig; }
     int getTimeSteps() const { return timeSteps; }
 
+    // Seed the run's RNG streams were derived from; rerun with
+    // config.rngSeed set to this value to reproduce the trajectory
+    uint64_t getRngSeed() const { return rngSeed; }
+
+    /**
+     * Attaches the run's hot-path instrumentation: per-phase step timers
+     * and spatial query/migration counters, all zeroed unless the build
+     * enabled ENABLE_INSTRUMENTATION.
+     */
+    void setInstrumentation(const instrumentation::StepMetrics& metrics,
+                            const instrumentation::QueryCounters& counters) {
+        stepMetrics = metrics;
+        queryCounters = counters;
+    }
+
+    const instrumentation::StepMetrics& getStepMetrics() const { return stepMetrics; }
+    const instrumentation::QueryCounters& getQueryCounters() const { return queryCounters; }
+
+    // The instrumentation rendered as a JSON object, ready to print or
+    // write next to the run's other outputs
+    std::string instrumentationJson() const {
+        return instrumentation::toJson(stepMetrics, queryCounters);
+    }
+
     // Simulation data
     std::vector<int> prey_history;
     std::vector<int> predator_history;
@@ -53,21 +87,8 @@ public:
     SimulationConfig simulationConfig; 
     int timeSteps; 
     std::chrono::milliseconds executionTime;
-    int normalizedPreyCount; 
-
-
-private:
-
-
-    
-    // Visualization constants
-    static constexpr unsigned int WINDOW_WIDTH = 800;
-    static constexpr unsigned int WINDOW_HEIGHT = 600;
-    static constexpr float MARGIN = 50.f;
-
-    // Helper methods for visualization
-    void drawAxes(sf::RenderWindow& window) const;
-    void drawGraph(sf::RenderWindow& window) const;
-    void drawLegend(sf::RenderWindow& window) const;
-    sf::Vector2f mapToScreen(float x, float y) const;
-}; 
\ No newline at end of file
+    int normalizedPreyCount;
+    uint64_t rngSeed;
+    instrumentation::StepMetrics stepMetrics;
+    instrumentation::QueryCounters queryCounters;
+};
\ No newline at end of file
@@ -1,209 +1,1040 @@
 #pragma once
 
 #include "position.hpp"
-#include "agent.hpp"
+#include "quantized_position.hpp"
+#include "agent_store.hpp"
+#include "distance_kernel.hpp"
+#include "forward_decls.hpp"
+#include <atomic>
+#include <mutex>
 #include <vector>
-#include <memory>
 #include <algorithm>
+#include <climits>
 #include <cmath>
 
-// A cache-efficient spatial partitioning system for agent lookup
+// A cache-efficient spatial partitioning system for agent lookup.
+// Cells store 32-bit agent handles; coordinates and types are read from the
+// AgentStore's contiguous arrays, so candidate scans stay on dense memory
+// instead of dereferencing a shared_ptr per agent.
 class SpatialGrid {
 private:
     // Fixed-size grid cells using a flat array for cache efficiency
-    std::vector<std::vector<std::shared_ptr<Agent>>> cells;
+    std::vector<std::vector<AgentHandle>> cells;
     int width, height;
     double cellSize;
-    
+    double worldWidth, worldHeight;
+
+#ifdef PP_INSTRUMENTATION
+    // Query instrumentation: candidates gathered vs. agents actually
+    // within radius, accumulated across all query paths. Relaxed atomics
+    // so concurrent tile workers can count without synchronizing — but
+    // shared atomics still bounce cache lines between cores, so like the
+    // step timers they are compiled out of default builds entirely.
+    mutable std::atomic<uint64_t> queryCount{0};
+    mutable std::atomic<uint64_t> candidateCount{0};
+    mutable std::atomic<uint64_t> hitCount{0};
+
+    // Cell migrations: moves that crossed a cell boundary and paid the
+    // remove/insert rebucketing cost. Counted only in per-move
+    // maintenance mode; rebuild mode rebuckets wholesale instead.
+    std::atomic<uint64_t> migrationCount{0};
+
+    void countQuery(uint64_t candidates, uint64_t hits) const {
+        queryCount.fetch_add(1, std::memory_order_relaxed);
+        candidateCount.fetch_add(candidates, std::memory_order_relaxed);
+        hitCount.fetch_add(hits, std::memory_order_relaxed);
+    }
+    void countMigration() {
+        migrationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    // Instrumentation compiled out: the query loops carry no shared
+    // counters and occupancyStats() reports zeros for them
+    void countQuery(uint64_t, uint64_t) const {}
+    void countMigration() {}
+#endif
+
+    // Rebuild mode: instead of per-move cell maintenance, the whole index
+    // is counting-sorted once per step into a CSR layout (one contiguous
+    // handle array plus per-cell offsets), so maintenance is two linear
+    // passes and queries scan contiguous ranges
+    bool rebuildMode = false;
+    std::vector<AgentHandle> csrHandles;
+    std::vector<uint32_t> cellOffsets;   // size width*height + 1
+    std::vector<uint32_t> cellCursors;   // scatter cursors, reused per rebuild
+
+    // Per-cell opposite-type candidate summaries, shared by all agents
+    // querying from the same center cell in the same step. Keyed on the
+    // neighborhood's generation sum: mutations only ever increment a
+    // cell's generation, so any insert/remove/rebucket in the summarized
+    // area strictly increases the stamp and invalidates the entry.
+    // Candidates are stored as handles and coordinates are read live, so
+    // same-cell movement needs no invalidation. Single-threaded only;
+    // the controller leaves it off under parallel stepping.
+    struct CellSummary {
+        uint64_t stamp = 0;
+        bool valid = false;
+        int radiusCells = -1;
+        int centerX = INT_MIN, centerY = INT_MIN;  // raw, possibly off-grid
+        std::vector<AgentHandle> prey;
+        std::vector<AgentHandle> predators;
+    };
+    bool summaryCacheEnabled = false;
+    std::vector<uint64_t> cellGeneration;
+    std::vector<CellSummary> cellSummaries;
+    uint64_t rebuildGeneration = 0;  // folded into stamps; bumped by rebuild/clear
+
+    void bumpGeneration(int cellIdx) {
+        if (!cellGeneration.empty()) {
+            ++cellGeneration[cellIdx];
+        }
+    }
+
+    uint64_t neighborhoodStamp(int centerX, int centerY, int cellRadius) const {
+        uint64_t stamp = rebuildGeneration;
+        for (int y = std::max(0, centerY - cellRadius);
+             y <= std::min(height - 1, centerY + cellRadius); ++y) {
+            for (int x = std::max(0, centerX - cellRadius);
+                 x <= std::min(width - 1, centerX + cellRadius); ++x) {
+                stamp += cellGeneration[y * width + x];
+            }
+        }
+        return stamp;
+    }
+
+    // Lazily (re)gathers the neighborhood's live handles, split by type.
+    // The raw center may lie off-grid (wall-clamped positions land at
+    // exactly 1.0); the summary is stored at the clamped cell but keyed
+    // on the raw center, so its window always matches the cell window
+    // the uncached spiral would walk for the same position.
+    const CellSummary& summarizeCell(int centerX, int centerY, int cellRadius) {
+        const int centerIdx = std::clamp(centerY, 0, height - 1) * width +
+                              std::clamp(centerX, 0, width - 1);
+        CellSummary& summary = cellSummaries[centerIdx];
+        const uint64_t stamp = neighborhoodStamp(centerX, centerY, cellRadius);
+        if (summary.valid && summary.stamp == stamp &&
+            summary.radiusCells == cellRadius &&
+            summary.centerX == centerX && summary.centerY == centerY) {
+            return summary;
+        }
+
+        summary.prey.clear();
+        summary.predators.clear();
+        const uint8_t* alive = store.aliveData();
+        const uint8_t* types = store.typeData();
+        for (int y = std::max(0, centerY - cellRadius);
+             y <= std::min(height - 1, centerY + cellRadius); ++y) {
+            for (int x = std::max(0, centerX - cellRadius);
+                 x <= std::min(width - 1, centerX + cellRadius); ++x) {
+                auto [cellData, cellCount] = cellSpan(y * width + x);
+                for (size_t k = 0; k < cellCount; ++k) {
+                    AgentHandle other = cellData[k];
+                    if (!alive[other]) continue;
+                    if (static_cast<Agent::Type>(types[other]) == Agent::PREY) {
+                        summary.prey.push_back(other);
+                    } else {
+                        summary.predators.push_back(other);
+                    }
+                }
+            }
+        }
+        summary.stamp = stamp;
+        summary.radiusCells = cellRadius;
+        summary.centerX = centerX;
+        summary.centerY = centerY;
+        summary.valid = true;
+        return summary;
+    }
+
+    // Quantized mode: the cell grid is rounded down to a power of two
+    // per axis so the cell index of a fixed-point coordinate is a single
+    // shift, and the spiral query tests candidates in integer
+    // arithmetic against the store's uint32 mirror. cellSize grows to
+    // worldExtent / 2^k, never below the requested size, so query
+    // windows stay conservative.
+    bool quantizedCells = false;
+    int cellShiftX = 0, cellShiftY = 0;
+
+    static int floorLog2(int v) {
+        int log = 0;
+        while (v > 1) {
+            v >>= 1;
+            ++log;
+        }
+        return log;
+    }
+
+    // Grid dimensions for a requested cell size: the plain ceil in the
+    // default mode, power-of-two cells (and the matching coordinate
+    // shifts) in quantized mode
+    void deriveGridDims(double requestedCellSize) {
+        cellSize = requestedCellSize;
+        width = static_cast<int>(std::ceil(worldWidth / cellSize));
+        height = static_cast<int>(std::ceil(worldHeight / cellSize));
+        if (quantizedCells) {
+            width = 1 << floorLog2(std::max(width, 1));
+            height = 1 << floorLog2(std::max(height, 1));
+            cellShiftX = quantized::kCoordBits - floorLog2(width);
+            cellShiftY = quantized::kCoordBits - floorLog2(height);
+            cellSize = std::max(worldWidth / width, worldHeight / height);
+        }
+    }
+
+    // Toroidal mode: cell indexing is modular and neighbor walks go
+    // through a precomputed per-cell table of wrapped neighbor cells,
+    // each carrying the world shift that maps its contents into the
+    // querying cell's frame. The gather loops then add the shift to the
+    // candidate coordinates, so the unchanged Euclidean distance kernel
+    // tests true torus distances with zero boundary branches per
+    // candidate.
+    bool torus = false;
+
+    struct WrappedNeighbor {
+        int32_t cell;
+        double shiftX, shiftY;
+    };
+    // Lazily (re)built when a query arrives with a new cell radius; all
+    // concurrent queries share one radius (the stepping paths do), which
+    // the release/acquire pair on wrappedRadius relies on
+    mutable std::vector<WrappedNeighbor> wrappedNeighbors;
+    mutable std::atomic<int> wrappedRadius{-1};
+    mutable size_t wrappedStride = 0;
+    mutable std::mutex wrappedMutex;
+
+    // Largest radius that visits each cell at most once; queries beyond
+    // it are clamped rather than double-counting across the seam
+    int clampTorusRadius(int cellRadius) const {
+        return std::min(cellRadius, (std::min(width, height) - 1) / 2);
+    }
+
+    void buildWrappedNeighbors(int cellRadius) const {
+        const int span = 2 * cellRadius + 1;
+        wrappedStride = static_cast<size_t>(span) * span;
+        wrappedNeighbors.resize(static_cast<size_t>(width) * height * wrappedStride);
+        size_t out = 0;
+        for (int cy = 0; cy < height; ++cy) {
+            for (int cx = 0; cx < width; ++cx) {
+                for (int dy = -cellRadius; dy <= cellRadius; ++dy) {
+                    for (int dx = -cellRadius; dx <= cellRadius; ++dx) {
+                        int nx = cx + dx;
+                        int ny = cy + dy;
+                        double sx = 0.0, sy = 0.0;
+                        if (nx < 0)            { nx += width;  sx = -worldWidth; }
+                        else if (nx >= width)  { nx -= width;  sx = worldWidth; }
+                        if (ny < 0)            { ny += height; sy = -worldHeight; }
+                        else if (ny >= height) { ny -= height; sy = worldHeight; }
+                        wrappedNeighbors[out++] = {ny * width + nx, sx, sy};
+                    }
+                }
+            }
+        }
+    }
+
+    // The table row for one center cell, rebuilding if the radius changed
+    const WrappedNeighbor* wrappedRow(int centerIdx, int cellRadius) const {
+        cellRadius = clampTorusRadius(cellRadius);
+        if (wrappedRadius.load(std::memory_order_acquire) != cellRadius) {
+            std::lock_guard<std::mutex> lock(wrappedMutex);
+            if (wrappedRadius.load(std::memory_order_relaxed) != cellRadius) {
+                buildWrappedNeighbors(cellRadius);
+                wrappedRadius.store(cellRadius, std::memory_order_release);
+            }
+        }
+        return wrappedNeighbors.data() + static_cast<size_t>(centerIdx) * wrappedStride;
+    }
+
+    // Modular wrap of a cell coordinate, correct for negatives
+    static int wrapCell(int c, int extent) {
+        c %= extent;
+        return c < 0 ? c + extent : c;
+    }
+
+    // Span of handles for one cell, valid in either storage mode
+    inline std::pair<const AgentHandle*, size_t> cellSpan(int cellIdx) const {
+        if (rebuildMode) {
+            uint32_t beginIndex = cellOffsets[cellIdx];
+            return {csrHandles.data() + beginIndex, cellOffsets[cellIdx + 1] - beginIndex};
+        }
+        const auto& cell = cells[cellIdx];
+        return {cell.data(), cell.size()};
+    }
+
+    // Coordinate/type arrays backing the handles
+    const AgentStore& store;
+
+    // Reused scratch buffers for batched distance tests; thread_local so
+    // concurrent tile workers can query without sharing state
+    static std::vector<double>& scratchXs() {
+        static thread_local std::vector<double> buf;
+        return buf;
+    }
+    static std::vector<double>& scratchYs() {
+        static thread_local std::vector<double> buf;
+        return buf;
+    }
+    static std::vector<AgentHandle>& scratchHandles() {
+        static thread_local std::vector<AgentHandle> buf;
+        return buf;
+    }
+
     // Inlined cell calculation for speed
     inline int getCellIndex(const Position& pos) const {
+        if (quantizedCells) {
+            // Multiply and shift instead of divide and floor; the
+            // full-range coordinate needs no clamp and wraps correctly
+            // for the torus by construction
+            int x = static_cast<int>(quantized::fromUnit(pos.x) >> cellShiftX);
+            int y = static_cast<int>(quantized::fromUnit(pos.y) >> cellShiftY);
+            return y * width + x;
+        }
         int x = static_cast<int>(std::floor(pos.x / cellSize));
         int y = static_cast<int>(std::floor(pos.y / cellSize));
-        // Clamp to grid boundaries
-        x = std::clamp(x, 0, width - 1);
-        y = std::clamp(y, 0, height - 1);
+        if (torus) {
+            // Modular indexing: no wall cells to pile up in
+            x = wrapCell(x, width);
+            y = wrapCell(y, height);
+        } else {
+            // Clamp to grid boundaries
+            x = std::clamp(x, 0, width - 1);
+            y = std::clamp(y, 0, height - 1);
+        }
         return y * width + x;
     }
 
+    // Swap-and-pop removal of a handle from a cell
+    static void removeFromCell(std::vector<AgentHandle>& cell, AgentHandle handle) {
+        for (size_t i = 0; i < cell.size(); ++i) {
+            if (cell[i] == handle) {
+                if (i != cell.size() - 1) {
+                    std::swap(cell[i], cell.back());
+                }
+                cell.pop_back();
+                break;
+            }
+        }
+    }
+
 public:
-    SpatialGrid(double worldWidth, double worldHeight, double cellSize)
-        : cellSize(cellSize) {
-        width = static_cast<int>(std::ceil(worldWidth / cellSize));
-        height = static_cast<int>(std::ceil(worldHeight / cellSize));
+    SpatialGrid(double worldWidth, double worldHeight, double cellSize,
+                const AgentStore& store)
+        : cellSize(cellSize), worldWidth(worldWidth), worldHeight(worldHeight),
+          store(store) {
+        deriveGridDims(cellSize);
         cells.resize(width * height);
-        
+
         // Reserve reasonable space for each cell to avoid reallocations
         for (auto& cell : cells) {
             cell.reserve(10); // Adjust based on expected density
         }
     }
-    
-    // Fast agent insertion
-    void insert(const std::shared_ptr<Agent>& agent) {
-        int cellIdx = getCellIndex(agent->getPosition());
-        cells[cellIdx].push_back(agent);
+
+    /**
+     * Rebuilds the grid with a new cell size and re-buckets every live
+     * agent from the store. Used by cell-size auto-tuning; must only be
+     * called between steps, as it invalidates cellAgents() references.
+     *
+     * @param newCellSize The cell edge length to re-bucket with
+     */
+    void reconfigure(double newCellSize) {
+        deriveGridDims(newCellSize);
+        cells.assign(static_cast<size_t>(width) * height, {});
+        if (summaryCacheEnabled) {
+            setSummaryCache(true);  // re-size the cache to the new geometry
+        }
+        wrappedRadius.store(-1, std::memory_order_release);  // new geometry, new table
+
+        if (rebuildMode) {
+            cellOffsets.assign(static_cast<size_t>(width) * height + 1, 0);
+            cellCursors.assign(static_cast<size_t>(width) * height, 0);
+            rebuild();
+            return;
+        }
+        const size_t slots = store.capacity();
+        const uint8_t* alive = store.aliveData();
+        for (size_t i = 0; i < slots; ++i) {
+            if (alive[i]) {
+                insert(static_cast<AgentHandle>(i));
+            }
+        }
     }
-    
-    // Fast agent removal with swap-and-pop
-    void remove(const std::shared_ptr<Agent>& agent) {
-        int cellIdx = getCellIndex(agent->getPosition());
-        auto& cell = cells[cellIdx];
-        
-        for (size_t i = 0; i < cell.size(); ++i) {
-            if (cell[i]->getId() == agent->getId()) {
-                // Swap with last element and pop (O(1) removal)
-                if (i != cell.size() - 1) {
-                    std::swap(cell[i], cell.back());
-                }
-                cell.pop_back();
-                break;
+
+    double getCellSize() const { return cellSize; }
+
+    // Grid dimensions in cells, for tile partitioning
+    int cellsWide() const { return width; }
+    int cellsHigh() const { return height; }
+
+    /**
+     * Per-run occupancy and query-efficiency statistics.
+     * histogram[n] counts cells holding exactly n agents, with the last
+     * bucket collecting every larger cell; candidates vs. hits measure
+     * how much of each neighbor query's gathered work was wasted. The
+     * query counters are zero unless the build enabled
+     * ENABLE_INSTRUMENTATION; the occupancy fields are always computed.
+     */
+    struct OccupancyStats {
+        size_t liveAgents = 0;
+        size_t nonEmptyCells = 0;
+        size_t maxCellOccupancy = 0;
+        double meanOccupancy = 0.0;  // over non-empty cells
+        std::vector<size_t> histogram;
+        uint64_t queries = 0;
+        uint64_t candidates = 0;
+        uint64_t hits = 0;
+        uint64_t cellMigrations = 0;
+    };
+
+    /**
+     * Computes the occupancy histogram and snapshots the query counters.
+     *
+     * @param histogramBuckets Exact-count buckets before the overflow bucket
+     * @return The current occupancy statistics
+     */
+    OccupancyStats occupancyStats(size_t histogramBuckets = 16) const {
+        OccupancyStats stats;
+        stats.histogram.assign(histogramBuckets + 1, 0);
+        const size_t cellCount = static_cast<size_t>(width) * height;
+        for (size_t c = 0; c < cellCount; ++c) {
+            size_t occupancy = cellSpan(static_cast<int>(c)).second;
+            stats.liveAgents += occupancy;
+            stats.maxCellOccupancy = std::max(stats.maxCellOccupancy, occupancy);
+            if (occupancy > 0) ++stats.nonEmptyCells;
+            ++stats.histogram[std::min(occupancy, histogramBuckets)];
+        }
+        if (stats.nonEmptyCells > 0) {
+            stats.meanOccupancy = static_cast<double>(stats.liveAgents)
+                                  / static_cast<double>(stats.nonEmptyCells);
+        }
+#ifdef PP_INSTRUMENTATION
+        stats.queries = queryCount.load(std::memory_order_relaxed);
+        stats.candidates = candidateCount.load(std::memory_order_relaxed);
+        stats.hits = hitCount.load(std::memory_order_relaxed);
+        stats.cellMigrations = migrationCount.load(std::memory_order_relaxed);
+#endif
+        return stats;
+    }
+
+    // Restarts the candidate/hit accounting, e.g. per step or per run
+    void resetQueryCounters() {
+#ifdef PP_INSTRUMENTATION
+        queryCount.store(0, std::memory_order_relaxed);
+        candidateCount.store(0, std::memory_order_relaxed);
+        hitCount.store(0, std::memory_order_relaxed);
+        migrationCount.store(0, std::memory_order_relaxed);
+#endif
+    }
+
+    /**
+     * Enables or disables the per-cell opposite-type candidate cache.
+     * Not safe under concurrent queries; parallel stepping keeps it off.
+     *
+     * @param enabled Whether co-located agents share candidate summaries
+     */
+    void setSummaryCache(bool enabled) {
+        summaryCacheEnabled = enabled;
+        if (enabled) {
+            cellGeneration.assign(static_cast<size_t>(width) * height, 0);
+            cellSummaries.assign(static_cast<size_t>(width) * height, {});
+        } else {
+            cellGeneration.clear();
+            cellGeneration.shrink_to_fit();
+            cellSummaries.clear();
+            cellSummaries.shrink_to_fit();
+        }
+    }
+
+    bool isSummaryCacheEnabled() const { return summaryCacheEnabled; }
+
+    /**
+     * Enables or disables toroidal (periodic) boundaries. Cell indexing
+     * becomes modular and every neighbor walk reads the precomputed
+     * wrapped-neighbor table; the summary cache is bypassed in this mode
+     * because its candidate lists cannot carry per-copy world shifts.
+     * Only call between steps, while no queries are in flight.
+     *
+     * @param enabled Whether the world wraps around
+     */
+    void setTorusMode(bool enabled) {
+        torus = enabled;
+        wrappedRadius.store(-1, std::memory_order_release);
+    }
+
+    bool isTorusMode() const { return torus; }
+
+    /**
+     * Enables or disables fixed-point cell indexing. The cell grid is
+     * re-bucketed onto power-of-two dimensions per axis so indexing a
+     * coordinate is a shift of its quantized value; the store's
+     * quantized mirror should be enabled alongside so the rebuild and
+     * spiral-query paths can read integer coordinates directly. Assumes
+     * the unit world the simulation always uses. Only call between steps.
+     *
+     * @param enabled Whether cell indexing runs on quantized coordinates
+     */
+    void setQuantizedCells(bool enabled) {
+        quantizedCells = enabled;
+        reconfigure(cellSize);
+    }
+
+    bool isQuantizedCells() const { return quantizedCells; }
+
+    // Read access to a single cell's handle list
+    const std::vector<AgentHandle>& cellAgents(int x, int y) const {
+        return cells[y * width + x];
+    }
+
+    /**
+     * Switches between per-move maintenance and once-per-step rebuilds.
+     * In rebuild mode, insert/remove/updatePosition become no-ops and the
+     * caller must invoke rebuild() at the top of every timestep; cell
+     * membership is then stale by at most one step's movement, while
+     * distance tests still read live coordinates. Agents born mid-step
+     * become visible to queries at the next rebuild.
+     */
+    void setRebuildMode(bool enabled) {
+        rebuildMode = enabled;
+        if (enabled) {
+            cellOffsets.assign(static_cast<size_t>(width) * height + 1, 0);
+            cellCursors.assign(static_cast<size_t>(width) * height, 0);
+        }
+    }
+
+    bool isRebuildMode() const { return rebuildMode; }
+
+    /**
+     * Counting-sort rebuild of the CSR index from the store's live slots:
+     * one pass to count per-cell occupancy, a prefix sum over the offsets,
+     * and one pass to scatter handles. All passes stream contiguous memory.
+     */
+    void rebuild() {
+        const size_t cellCount = static_cast<size_t>(width) * height;
+        const size_t slots = store.capacity();
+        const uint8_t* alive = store.aliveData();
+        const double* xs = store.xData();
+        const double* ys = store.yData();
+
+        std::fill(cellOffsets.begin(), cellOffsets.end(), 0);
+
+        // In quantized mode both passes index cells by shifting the
+        // store's integer mirror, skipping the divide entirely
+        const uint32_t* qxs = quantizedCells && store.hasQuantizedMirror()
+                                  ? store.qxData() : nullptr;
+        const uint32_t* qys = qxs ? store.qyData() : nullptr;
+        auto cellOf = [&](size_t i) {
+            if (qxs) {
+                return static_cast<int>(qys[i] >> cellShiftY) * width +
+                       static_cast<int>(qxs[i] >> cellShiftX);
             }
+            return getCellIndex(Position(xs[i], ys[i]));
+        };
+
+        // Pass 1: per-cell counts (shifted by one for the prefix sum)
+        for (size_t i = 0; i < slots; ++i) {
+            if (alive[i]) {
+                ++cellOffsets[cellOf(i) + 1];
+            }
+        }
+
+        // Prefix sum: offsets[c] .. offsets[c+1] delimit cell c
+        for (size_t c = 0; c < cellCount; ++c) {
+            cellOffsets[c + 1] += cellOffsets[c];
         }
+
+        // Pass 2: scatter handles to their cell's range
+        csrHandles.resize(cellOffsets[cellCount]);
+        std::copy(cellOffsets.begin(), cellOffsets.end() - 1, cellCursors.begin());
+        for (size_t i = 0; i < slots; ++i) {
+            if (alive[i]) {
+                csrHandles[cellCursors[cellOf(i)]++] = static_cast<AgentHandle>(i);
+            }
+        }
+
+        // Whole-index rebucketing invalidates every cached summary
+        ++rebuildGeneration;
+    }
+
+    // Fast agent insertion
+    void insert(AgentHandle handle) {
+        if (rebuildMode) return;  // picked up by the next rebuild
+        int cellIdx = getCellIndex(store.position(handle));
+        cells[cellIdx].push_back(handle);
+        bumpGeneration(cellIdx);
     }
-    
+
+    // Fast agent removal with swap-and-pop
+    void remove(AgentHandle handle) {
+        if (rebuildMode) return;  // dropped by the next rebuild
+        int cellIdx = getCellIndex(store.position(handle));
+        removeFromCell(cells[cellIdx], handle);
+        bumpGeneration(cellIdx);
+    }
+
     // Update agent position in the grid
-    void updatePosition(const std::shared_ptr<Agent>& agent, 
-                        const Position& oldPos) {
+    void updatePosition(AgentHandle handle, const Position& oldPos) {
+        if (rebuildMode) return;  // rebucketed by the next rebuild
         int oldCellIdx = getCellIndex(oldPos);
-        int newCellIdx = getCellIndex(agent->getPosition());
-        
+        int newCellIdx = getCellIndex(store.position(handle));
+
         if (oldCellIdx != newCellIdx) {
-            // Remove from old cell
-            auto& oldCell = cells[oldCellIdx];
-            for (size_t i = 0; i < oldCell.size(); ++i) {
-                if (oldCell[i]->getId() == agent->getId()) {
-                    if (i != oldCell.size() - 1) {
-                        std::swap(oldCell[i], oldCell.back());
-                    }
-                    oldCell.pop_back();
-                    break;
-                }
-            }
-            
-            // Add to new cell
-            cells[newCellIdx].push_back(agent);
+            // Remove from old cell, add to new cell
+            removeFromCell(cells[oldCellIdx], handle);
+            cells[newCellIdx].push_back(handle);
+            bumpGeneration(oldCellIdx);
+            bumpGeneration(newCellIdx);
+            countMigration();
         }
     }
-    
-    // Get all neighboring agents efficiently
-    std::vector<std::shared_ptr<Agent>> getNeighbors(const Position& pos, double radius) {
-        std::vector<std::shared_ptr<Agent>> neighbors;
+
+    // Visit every agent within the radius, allocating nothing beyond the
+    // thread-local scratch reused across calls. This is the core that the
+    // buffer and allocating variants below are built on.
+    template <typename Visitor>
+    void visitNeighbors(const Position& pos, double radius, Visitor&& visit) {
         double radiusSquared = radius * radius;
-        
+
         // Calculate cell bounds for the search
         int cellRadius = static_cast<int>(std::ceil(radius / cellSize));
         int centerX = static_cast<int>(std::floor(pos.x / cellSize));
         int centerY = static_cast<int>(std::floor(pos.y / cellSize));
-        
-        // Pre-allocate to avoid reallocations
-        int potentialNeighbors = 0;
-        for (int y = std::max(0, centerY - cellRadius); 
-             y <= std::min(height - 1, centerY + cellRadius); ++y) {
-            for (int x = std::max(0, centerX - cellRadius); 
-                 x <= std::min(width - 1, centerX + cellRadius); ++x) {
-                potentialNeighbors += cells[y * width + x].size();
+
+        // Gather live candidates from surrounding cells into dense buffers
+        const double* xs = store.xData();
+        const double* ys = store.yData();
+        const uint8_t* alive = store.aliveData();
+        auto& candXs = scratchXs();
+        auto& candYs = scratchYs();
+        auto& candHandles = scratchHandles();
+        candXs.clear();
+        candYs.clear();
+        candHandles.clear();
+        if (torus) {
+            // Walk the precomputed wrapped neighborhood; the per-cell
+            // shift maps candidates into the query's frame so the plain
+            // Euclidean kernel below tests true torus distances
+            const int centerIdx = wrapCell(centerY, height) * width + wrapCell(centerX, width);
+            const WrappedNeighbor* row = wrappedRow(centerIdx, cellRadius);
+            for (size_t n = 0; n < wrappedStride; ++n) {
+                auto [cellData, cellCount] = cellSpan(row[n].cell);
+                for (size_t k = 0; k < cellCount; ++k) {
+                    AgentHandle handle = cellData[k];
+                    if (alive[handle]) {
+                        candXs.push_back(xs[handle] + row[n].shiftX);
+                        candYs.push_back(ys[handle] + row[n].shiftY);
+                        candHandles.push_back(handle);
+                    }
+                }
             }
-        }
-        neighbors.reserve(potentialNeighbors);
-        
-        // Gather neighbors from surrounding cells
-        for (int y = std::max(0, centerY - cellRadius); 
-             y <= std::min(height - 1, centerY + cellRadius); ++y) {
-            for (int x = std::max(0, centerX - cellRadius); 
-                 x <= std::min(width - 1, centerX + cellRadius); ++x) {
-                
-                const auto& cellAgents = cells[y * width + x];
-                for (const auto& agent : cellAgents) {
-                    if (agent->isAlive() && 
-                        pos.distanceSquaredTo(agent->getPosition()) <= radiusSquared) {
-                        neighbors.push_back(agent);
+        } else {
+            for (int y = std::max(0, centerY - cellRadius);
+                 y <= std::min(height - 1, centerY + cellRadius); ++y) {
+                for (int x = std::max(0, centerX - cellRadius);
+                     x <= std::min(width - 1, centerX + cellRadius); ++x) {
+
+                    auto [cellData, cellCount] = cellSpan(y * width + x);
+                    for (size_t k = 0; k < cellCount; ++k) {
+                        AgentHandle handle = cellData[k];
+                        if (alive[handle]) {
+                            candXs.push_back(xs[handle]);
+                            candYs.push_back(ys[handle]);
+                            candHandles.push_back(handle);
+                        }
                     }
                 }
             }
         }
-        
-        return neighbors;
+
+        // Batched distance test: one bitmask per 64 candidates
+        uint64_t hits = 0;
+        for (size_t base = 0; base < candHandles.size(); base += distance_kernel::kBatchSize) {
+            size_t count = std::min(distance_kernel::kBatchSize, candHandles.size() - base);
+            uint64_t mask = distance_kernel::inRadiusMask(
+                candXs.data() + base, candYs.data() + base, count,
+                pos.x, pos.y, radiusSquared);
+            while (mask) {
+                visit(candHandles[base + distance_kernel::firstHit(mask)]);
+                mask = distance_kernel::clearFirstHit(mask);
+                ++hits;
+            }
+        }
+        countQuery(candHandles.size(), hits);
     }
-    
-    // Get neighbors of specific type (avoiding type checks in hot loops)
-    std::vector<std::shared_ptr<Agent>> getNeighborsOfType(
-            const Position& pos, double radius, Agent::Type type) {
-        
-        std::vector<std::shared_ptr<Agent>> neighbors;
+
+    // Type-filtered visitor variant (avoiding shared_ptr hops in hot loops)
+    template <typename Visitor>
+    void visitNeighborsOfType(const Position& pos, double radius,
+                              Agent::Type type, Visitor&& visit) {
         double radiusSquared = radius * radius;
-        
-        // Similar to getNeighbors, but with type filtering
+
+        // Similar to visitNeighbors, but with type filtering in the gather
         int cellRadius = static_cast<int>(std::ceil(radius / cellSize));
         int centerX = static_cast<int>(std::floor(pos.x / cellSize));
         int centerY = static_cast<int>(std::floor(pos.y / cellSize));
-        
-        // Conservative capacity estimation
-        neighbors.reserve((2 * cellRadius + 1) * (2 * cellRadius + 1) * 5);
-        
-        for (int y = std::max(0, centerY - cellRadius); 
-             y <= std::min(height - 1, centerY + cellRadius); ++y) {
-            for (int x = std::max(0, centerX - cellRadius); 
-                 x <= std::min(width - 1, centerX + cellRadius); ++x) {
-                
-                const auto& cellAgents = cells[y * width + x];
-                for (const auto& agent : cellAgents) {
-                    if (agent->isAlive() && 
-                        agent->getType() == type &&
-                        pos.distanceSquaredTo(agent->getPosition()) <= radiusSquared) {
-                        neighbors.push_back(agent);
+
+        const double* xs = store.xData();
+        const double* ys = store.yData();
+        const uint8_t* alive = store.aliveData();
+        const uint8_t* types = store.typeData();
+        const uint8_t wanted = static_cast<uint8_t>(type);
+
+        auto& candXs = scratchXs();
+        auto& candYs = scratchYs();
+        auto& candHandles = scratchHandles();
+        candXs.clear();
+        candYs.clear();
+        candHandles.clear();
+        if (torus) {
+            const int centerIdx = wrapCell(centerY, height) * width + wrapCell(centerX, width);
+            const WrappedNeighbor* row = wrappedRow(centerIdx, cellRadius);
+            for (size_t n = 0; n < wrappedStride; ++n) {
+                auto [cellData, cellCount] = cellSpan(row[n].cell);
+                for (size_t k = 0; k < cellCount; ++k) {
+                    AgentHandle handle = cellData[k];
+                    if (alive[handle] && types[handle] == wanted) {
+                        candXs.push_back(xs[handle] + row[n].shiftX);
+                        candYs.push_back(ys[handle] + row[n].shiftY);
+                        candHandles.push_back(handle);
+                    }
+                }
+            }
+        } else {
+            for (int y = std::max(0, centerY - cellRadius);
+                 y <= std::min(height - 1, centerY + cellRadius); ++y) {
+                for (int x = std::max(0, centerX - cellRadius);
+                     x <= std::min(width - 1, centerX + cellRadius); ++x) {
+
+                    auto [cellData, cellCount] = cellSpan(y * width + x);
+                    for (size_t k = 0; k < cellCount; ++k) {
+                        AgentHandle handle = cellData[k];
+                        if (alive[handle] && types[handle] == wanted) {
+                            candXs.push_back(xs[handle]);
+                            candYs.push_back(ys[handle]);
+                            candHandles.push_back(handle);
+                        }
                     }
                 }
             }
         }
-        
+
+        uint64_t hits = 0;
+        for (size_t base = 0; base < candHandles.size(); base += distance_kernel::kBatchSize) {
+            size_t count = std::min(distance_kernel::kBatchSize, candHandles.size() - base);
+            uint64_t mask = distance_kernel::inRadiusMask(
+                candXs.data() + base, candYs.data() + base, count,
+                pos.x, pos.y, radiusSquared);
+            while (mask) {
+                visit(candHandles[base + distance_kernel::firstHit(mask)]);
+                mask = distance_kernel::clearFirstHit(mask);
+                ++hits;
+            }
+        }
+        countQuery(candHandles.size(), hits);
+    }
+
+    // Caller-provided buffer variants: clear and fill the output vector,
+    // so a reused buffer amortizes to zero allocations
+    void getNeighbors(const Position& pos, double radius, std::vector<AgentHandle>& out) {
+        out.clear();
+        visitNeighbors(pos, radius, [&out](AgentHandle handle) { out.push_back(handle); });
+    }
+
+    void getNeighborsOfType(const Position& pos, double radius, Agent::Type type,
+                            std::vector<AgentHandle>& out) {
+        out.clear();
+        visitNeighborsOfType(pos, radius, type,
+                             [&out](AgentHandle handle) { out.push_back(handle); });
+    }
+
+    // Allocating convenience wrappers; prefer the buffer or visitor forms
+    // in per-step code
+    std::vector<AgentHandle> getNeighbors(const Position& pos, double radius) {
+        std::vector<AgentHandle> neighbors;
+        getNeighbors(pos, radius, neighbors);
+        return neighbors;
+    }
+
+    std::vector<AgentHandle> getNeighborsOfType(
+            const Position& pos, double radius, Agent::Type type) {
+        std::vector<AgentHandle> neighbors;
+        getNeighborsOfType(pos, radius, type, neighbors);
         return neighbors;
     }
-    
+
+    /**
+     * Answers the interaction test for every live agent in one pass.
+     * Cells are walked in order and each cell's neighborhood is gathered
+     * once into per-type candidate arrays, so agents sharing a cell share
+     * all of the cell decoding and candidate gathering work that the
+     * per-agent query redoes from scratch.
+     *
+     * @param radius The interaction radius
+     * @param flags Output, indexed by handle: 1 if an opposite-type
+     *              agent lies within the radius, else 0
+     */
+    void computeInteractionFlags(double radius, std::vector<uint8_t>& flags) const {
+        flags.assign(store.capacity(), 0);
+        const double radiusSquared = radius * radius;
+        const int cellRadius = static_cast<int>(std::ceil(radius / cellSize));
+
+        const double* xs = store.xData();
+        const double* ys = store.yData();
+        const uint8_t* alive = store.aliveData();
+        const uint8_t* types = store.typeData();
+
+        static thread_local std::vector<double> preyXs, preyYs, predXs, predYs;
+
+        for (int cy = 0; cy < height; ++cy) {
+            for (int cx = 0; cx < width; ++cx) {
+                auto [cellData, cellCount] = cellSpan(cy * width + cx);
+                if (cellCount == 0) continue;
+
+                // Gather the neighborhood's candidates once per cell,
+                // split by type so each agent tests only the opposite set
+                preyXs.clear(); preyYs.clear();
+                predXs.clear(); predYs.clear();
+                if (torus) {
+                    const WrappedNeighbor* row = wrappedRow(cy * width + cx, cellRadius);
+                    for (size_t n = 0; n < wrappedStride; ++n) {
+                        auto [nData, nCount] = cellSpan(row[n].cell);
+                        for (size_t k = 0; k < nCount; ++k) {
+                            AgentHandle other = nData[k];
+                            if (!alive[other]) continue;
+                            if (static_cast<Agent::Type>(types[other]) == Agent::PREY) {
+                                preyXs.push_back(xs[other] + row[n].shiftX);
+                                preyYs.push_back(ys[other] + row[n].shiftY);
+                            } else {
+                                predXs.push_back(xs[other] + row[n].shiftX);
+                                predYs.push_back(ys[other] + row[n].shiftY);
+                            }
+                        }
+                    }
+                } else {
+                    for (int y = std::max(0, cy - cellRadius);
+                         y <= std::min(height - 1, cy + cellRadius); ++y) {
+                        for (int x = std::max(0, cx - cellRadius);
+                             x <= std::min(width - 1, cx + cellRadius); ++x) {
+                            auto [nData, nCount] = cellSpan(y * width + x);
+                            for (size_t k = 0; k < nCount; ++k) {
+                                AgentHandle other = nData[k];
+                                if (!alive[other]) continue;
+                                if (static_cast<Agent::Type>(types[other]) == Agent::PREY) {
+                                    preyXs.push_back(xs[other]);
+                                    preyYs.push_back(ys[other]);
+                                } else {
+                                    predXs.push_back(xs[other]);
+                                    predYs.push_back(ys[other]);
+                                }
+                            }
+                        }
+                    }
+                }
+
+                for (size_t k = 0; k < cellCount; ++k) {
+                    AgentHandle handle = cellData[k];
+                    if (!alive[handle]) continue;
+                    const bool isPrey =
+                        static_cast<Agent::Type>(types[handle]) == Agent::PREY;
+                    const auto& oppXs = isPrey ? predXs : preyXs;
+                    const auto& oppYs = isPrey ? predYs : preyYs;
+
+                    uint8_t hit = 0;
+                    for (size_t base = 0; base < oppXs.size() && !hit;
+                         base += distance_kernel::kBatchSize) {
+                        size_t count = std::min(distance_kernel::kBatchSize,
+                                                oppXs.size() - base);
+                        if (distance_kernel::inRadiusMask(
+                                oppXs.data() + base, oppYs.data() + base, count,
+                                xs[handle], ys[handle], radiusSquared) != 0) {
+                            hit = 1;
+                        }
+                    }
+                    flags[handle] = hit;
+                    countQuery(oppXs.size(), hit);
+                }
+            }
+        }
+    }
+
     // Check if any opposite-type neighbor exists (early exit optimization)
-    bool hasOppositeTypeNeighbor(const std::shared_ptr<Agent>& agent, double radius) {
-        if (!agent || !agent->isAlive()) return false;
-        
-        const Position& pos = agent->getPosition();
-        Agent::Type oppositeType = (agent->getType() == Agent::PREDATOR) ? 
-                                   Agent::PREY : Agent::PREDATOR;
+    bool hasOppositeTypeNeighbor(AgentHandle handle, double radius) {
+        if (handle == InvalidAgentHandle || !store.isAlive(handle)) return false;
+        return hasOppositeTypeNeighbor(handle, store.position(handle), radius);
+    }
+
+    // Same check centered on an explicit position, for callers whose agent
+    // has moved but whose store coordinates are not yet committed
+    bool hasOppositeTypeNeighbor(AgentHandle handle, const Position& pos, double radius) {
+        if (handle == InvalidAgentHandle || !store.isAlive(handle)) return false;
+
+        const uint8_t oppositeType = static_cast<uint8_t>(
+            (store.type(handle) == Agent::PREDATOR) ? Agent::PREY : Agent::PREDATOR);
         double radiusSquared = radius * radius;
-        
+
         // Get surrounding cells
         int cellRadius = static_cast<int>(std::ceil(radius / cellSize));
         int centerX = static_cast<int>(std::floor(pos.x / cellSize));
         int centerY = static_cast<int>(std::floor(pos.y / cellSize));
-        
+
+        if (summaryCacheEnabled && !torus) {
+            // Share the neighborhood gather with every other agent
+            // querying from this cell; only the exact distance test
+            // against the summarized candidates is per-agent. Torus
+            // queries skip the cache: its handle lists cannot say which
+            // wrapped copy of a candidate the querier should see.
+            const CellSummary& summary =
+                summarizeCell(centerX, centerY, cellRadius);
+            const std::vector<AgentHandle>& opposite =
+                (store.type(handle) == Agent::PREDATOR) ? summary.prey
+                                                        : summary.predators;
+            const double* liveXs = store.xData();
+            const double* liveYs = store.yData();
+            const uint8_t* liveFlags = store.aliveData();
+            const uint8_t* liveTypes = store.typeData();
+            const uint8_t summarizedType = static_cast<uint8_t>(
+                (store.type(handle) == Agent::PREDATOR) ? Agent::PREY
+                                                        : Agent::PREDATOR);
+            auto& batchXs = scratchXs();
+            auto& batchYs = scratchYs();
+            batchXs.clear();
+            batchYs.clear();
+            uint64_t tested = 0;
+            for (AgentHandle other : opposite) {
+                // Re-check liveness and type per candidate: in rebuild
+                // mode mutations do not bump generations, so a summary
+                // can outlive a death or a recycled slot's type flip
+                // within the step
+                if (!liveFlags[other] || liveTypes[other] != summarizedType) {
+                    continue;
+                }
+                batchXs.push_back(liveXs[other]);
+                batchYs.push_back(liveYs[other]);
+                ++tested;
+                if (batchXs.size() == distance_kernel::kBatchSize) {
+                    if (distance_kernel::inRadiusMask(
+                            batchXs.data(), batchYs.data(), batchXs.size(),
+                            pos.x, pos.y, radiusSquared) != 0) {
+                        countQuery(tested, 1);
+                        return true;
+                    }
+                    batchXs.clear();
+                    batchYs.clear();
+                }
+            }
+            if (!batchXs.empty() &&
+                distance_kernel::inRadiusMask(batchXs.data(), batchYs.data(),
+                                              batchXs.size(), pos.x, pos.y,
+                                              radiusSquared) != 0) {
+                countQuery(tested, 1);
+                return true;
+            }
+            countQuery(tested, 0);
+            return false;
+        }
+
+        const double* xs = store.xData();
+        const double* ys = store.yData();
+        const uint8_t* alive = store.aliveData();
+        const uint8_t* types = store.typeData();
+        auto& candXs = scratchXs();
+        auto& candYs = scratchYs();
+        uint64_t scanned = 0;
+
+        // Quantized mode tests candidates in integer arithmetic against
+        // the store's uint32 mirror, half the memory traffic of the
+        // double gather; the torus keeps the shifted double path
+        const uint32_t* qX = (!torus && quantizedCells && store.hasQuantizedMirror())
+                                 ? store.qxData() : nullptr;
+        const uint32_t* qY = qX ? store.qyData() : nullptr;
+        const uint32_t qpx = qX ? quantized::fromUnit(pos.x) : 0;
+        const uint32_t qpy = qX ? quantized::fromUnit(pos.y) : 0;
+        const uint64_t qr = qX ? quantized::radiusQuanta(radius) : 0;
+        const uint64_t qr2 = qX ? quantized::radiusSquaredQuanta(radius) : 0;
+
         // Check cells in spiral pattern (more likely to find matches near center)
-        for (int r = 0; r <= cellRadius; ++r) {
+        const int maxRadius = torus ? clampTorusRadius(cellRadius) : cellRadius;
+        for (int r = 0; r <= maxRadius; ++r) {
             // Check cells at distance r from center in a square pattern
             for (int dx = -r; dx <= r; ++dx) {
                 for (int dy = -r; dy <= r; ++dy) {
                     // Only check cells on the perimeter of the square
                     if (r > 0 && std::abs(dx) < r && std::abs(dy) < r) continue;
-                    
+
                     int x = centerX + dx;
                     int y = centerY + dy;
-                    
-                    if (x >= 0 && x < width && y >= 0 && y < height) {
-                        const auto& cellAgents = cells[y * width + x];
-                        for (const auto& other : cellAgents) {
-                            if (other->isAlive() && 
-                                other->getType() == oppositeType &&
-                                pos.distanceSquaredTo(other->getPosition()) <= radiusSquared) {
+                    double shiftX = 0.0, shiftY = 0.0;
+                    if (torus) {
+                        // Wrap the cell and shift its contents into the
+                        // query's frame, as the neighbor tables do
+                        if (x < 0)            { x += width;  shiftX = -worldWidth; }
+                        else if (x >= width)  { x -= width;  shiftX = worldWidth; }
+                        if (y < 0)            { y += height; shiftY = -worldHeight; }
+                        else if (y >= height) { y -= height; shiftY = worldHeight; }
+                    } else if (x < 0 || x >= width || y < 0 || y >= height) {
+                        continue;
+                    }
+
+                    auto [cellData, cellCount] = cellSpan(y * width + x);
+
+                    if (qX) {
+                        // Integer tests straight off the mirror arrays
+                        for (size_t k = 0; k < cellCount; ++k) {
+                            AgentHandle other = cellData[k];
+                            if (!alive[other] || types[other] != oppositeType) {
+                                continue;
+                            }
+                            ++scanned;
+                            if (quantized::withinRadius(qX[other], qY[other],
+                                                        qpx, qpy, qr, qr2)) {
+                                countQuery(scanned, 1);
+                                return true; // Early exit
+                            }
+                        }
+                        continue;
+                    }
+
+                    // Gather this cell's opposite-type candidates and test
+                    // them in full batches, flushing and refilling the way
+                    // visitNeighbors does, so a cell denser than one batch
+                    // never silently drops candidates
+                    candXs.clear();
+                    candYs.clear();
+                    for (size_t k = 0; k < cellCount; ++k) {
+                        AgentHandle other = cellData[k];
+                        if (!alive[other] || types[other] != oppositeType) {
+                            continue;
+                        }
+                        candXs.push_back(xs[other] + shiftX);
+                        candYs.push_back(ys[other] + shiftY);
+                        ++scanned;
+                        if (candXs.size() == distance_kernel::kBatchSize) {
+                            if (distance_kernel::inRadiusMask(
+                                    candXs.data(), candYs.data(), candXs.size(),
+                                    pos.x, pos.y, radiusSquared) != 0) {
+                                countQuery(scanned, 1);
                                 return true; // Early exit
                             }
+                            candXs.clear();
+                            candYs.clear();
                         }
                     }
+                    if (!candXs.empty() &&
+                        distance_kernel::inRadiusMask(candXs.data(), candYs.data(),
+                                                      candXs.size(), pos.x, pos.y,
+                                                      radiusSquared) != 0) {
+                        countQuery(scanned, 1);
+                        return true; // Early exit
+                    }
                 }
             }
         }
-        
+
+        countQuery(scanned, 0);
         return false;
     }
-    
+
     void clear() {
         for (auto& cell : cells) {
             cell.clear();
         }
+        ++rebuildGeneration;
     }
-};
\ No newline at end of file
+};
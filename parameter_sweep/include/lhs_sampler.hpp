@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <random>
 #include <algorithm>
@@ -12,7 +13,11 @@ public:
         double max;
     };
 
-    LHSSampler(const std::vector<ParameterRange>& ranges, int num_samples);
+    // seed 0 draws from random_device (historical behavior); any other
+    // value makes the sample set fully deterministic, so distributed
+    // workers can regenerate identical points from the seed alone
+    LHSSampler(const std::vector<ParameterRange>& ranges, int num_samples,
+               uint64_t seed = 0);
     
     // Generate a single sample configuration
     std::vector<double> generateSample();
@@ -23,6 +28,7 @@ public:
 private:
     std::vector<ParameterRange> ranges_;
     int num_samples_;
+    uint64_t seed_;
     std::vector<std::vector<double>> permutations_;
     
     void initializePermutations();
@@ -11,14 +11,40 @@ class ParameterSweep {
 public:
     ParameterSweep(const std::string& output_dir);
     void run(int num_samples, int num_reruns, int num_sims, int num_timesteps);
+
+    /**
+     * One worker process of a distributed sweep. All workers point at
+     * the same output directory and regenerate the identical sample set
+     * from lhs_seed (which must be nonzero), then pull samples
+     * dynamically from the shared mmapped result store — a claim CAS
+     * per sample gives load balancing without a coordinator, since
+     * sample runtimes vary wildly with NR and DF. The worker that
+     * completes the final sample exports the merged CSV. reset_claims
+     * releases claims orphaned by crashed workers; only pass it when no
+     * other worker is running.
+     */
+    void runDistributed(int num_samples, int num_reruns, int num_sims,
+                        int num_timesteps, uint64_t lhs_seed, int worker_id,
+                        bool reset_claims = false);
     
 private:
     std::string output_dir_;
     std::string generateOutputFilename() const;
-    std::tuple<double, double, double, double> runSingleSample(
+
+    // Runs one replicate simulation and returns its (prey, predator)
+    // means over the converged trailing window plus the predator
+    // extinction step (-1 if predators survived), all read from the
+    // controller's incremental accumulators in O(1)
+    std::tuple<double, double, int> runSingleReplicate(
         const SimulationConfig& config,
-        int num_reruns,
-        int num_sims,
         int num_timesteps
     );
-}; 
\ No newline at end of file
+
+    // Aggregates a sample's replicate matrix ([rerun][sim]) into
+    // (avg_prey, std_prey, avg_pred, std_pred) with the per-rerun
+    // mean-of-means statistics the CSV has always reported
+    static std::tuple<double, double, double, double> aggregateSample(
+        const std::vector<std::vector<double>>& prey,
+        const std::vector<std::vector<double>>& pred
+    );
+};
\ No newline at end of file
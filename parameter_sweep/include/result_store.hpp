@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Memory-mapped binary result store for parameter sweeps. One fixed-size
+ * record per sample holds the sampled parameters, the aggregated
+ * statistics and a completion flag; records are written in place through
+ * the mapping as samples finish, so completed work survives a crash and
+ * a restarted sweep schedules only the incomplete samples. The sampled
+ * parameters live in the store rather than being regenerated, because
+ * the LHS shuffle is seeded from random_device and would not reproduce.
+ *
+ * exportCsv() converts a store to the CSV schema analyze_sweep.py reads.
+ */
+class ResultStore {
+public:
+    // On-disk record layout; mapped in place, native endianness
+    struct SampleRecord {
+        double nr;
+        double dr;
+        double df;
+        double rf;
+        double avgPrey;
+        double stdPrey;
+        double avgPredators;
+        double stdPredators;
+        double normalizedPrey;
+        double extinctFraction;
+        double avgExtinctionStep;
+        uint32_t complete;  // written last, after every field above
+        uint32_t claimed;   // 0 = free, else claiming worker id + 1
+    };
+
+    /**
+     * Opens the store, adopting an existing file whose header matches
+     * the expected sample count, and creating a zeroed one otherwise.
+     *
+     * @param path Path of the store file
+     * @param sampleCount Number of samples the sweep will run
+     * @throws std::runtime_error if the file cannot be created or mapped
+     */
+    ResultStore(const std::string& path, int sampleCount);
+    ~ResultStore();
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    // True if an existing store was adopted; its parameters and any
+    // completed records are authoritative
+    bool resumed() const { return resumedFlag; }
+
+    bool isComplete(int sample) const { return records[sample].complete != 0; }
+
+    // Direct access to a sample's mmapped record
+    SampleRecord& record(int sample) { return records[sample]; }
+    const SampleRecord& record(int sample) const { return records[sample]; }
+
+    /**
+     * Publishes a record's statistics: fences so every field written
+     * before the call is visible, sets the completion flag and queues an
+     * asynchronous flush of the affected pages.
+     *
+     * @param sample The sample index to mark complete
+     */
+    void markComplete(int sample);
+
+    /**
+     * Atomically claims a sample for one worker process. The CAS runs
+     * on the shared mapping, so worker processes on the same host
+     * contend correctly; already-claimed and completed samples fail.
+     *
+     * @param sample The sample index to claim
+     * @param workerId The claiming worker's id
+     * @return True if this call took the claim
+     */
+    bool tryClaim(int sample, uint32_t workerId);
+
+    /**
+     * Clears claims on incomplete samples, releasing work orphaned by
+     * crashed workers. Only call while no worker is running.
+     */
+    void resetStaleClaims();
+
+    // True once every sample's completion flag is set
+    bool allComplete() const;
+
+    /**
+     * Writes the whole store to a CSV file in the sweep's existing
+     * schema; incomplete samples are skipped.
+     *
+     * @param path Path of the CSV file to create
+     * @return Number of completed samples exported
+     */
+    int exportCsv(const std::string& path) const;
+
+private:
+    int fd = -1;
+    uint8_t* base = nullptr;
+    size_t mappedSize = 0;
+    int sampleCount = 0;
+    bool resumedFlag = false;
+    SampleRecord* records = nullptr;
+};
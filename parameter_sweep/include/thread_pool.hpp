@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Work-stealing thread pool for running independent simulation tasks.
+ * Each worker owns a deque of tasks; submissions are distributed round-robin
+ * and idle workers steal from the far end of other workers' deques, so uneven
+ * task durations (e.g. parameter samples with very different NR/DF) still
+ * keep all cores busy.
+ */
+class ThreadPool {
+public:
+    /**
+     * Creates the pool and starts the worker threads.
+     *
+     * @param numThreads Number of worker threads (at least 1)
+     */
+    explicit ThreadPool(size_t numThreads)
+        : queues_(numThreads ? numThreads : 1) {
+        for (auto& q : queues_) {
+            q = std::make_unique<WorkQueue>();
+        }
+        for (size_t i = 0; i < queues_.size(); ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    /**
+     * Waits for all queued tasks to finish and joins the workers.
+     */
+    ~ThreadPool() {
+        done_.store(true);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            sleepCondition_.notify_all();
+        }
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Enqueues a task and returns a future for its result.
+     *
+     * @param task Callable taking no arguments
+     * @return A future holding the task's return value
+     */
+    template <typename F>
+    auto enqueue(F&& task) -> std::future<decltype(task())> {
+        using ResultType = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<ResultType()>>(
+            std::forward<F>(task));
+        std::future<ResultType> result = packaged->get_future();
+
+        size_t target = nextQueue_.fetch_add(1) % queues_.size();
+        {
+            std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+            queues_[target]->tasks.emplace_back([packaged] { (*packaged)(); });
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            sleepCondition_.notify_one();
+        }
+        return result;
+    }
+
+    /**
+     * Gets the number of worker threads in the pool.
+     *
+     * @return The worker count
+     */
+    size_t workerCount() const { return workers_.size(); }
+
+private:
+    struct WorkQueue {
+        std::deque<std::function<void()>> tasks;
+        std::mutex mutex;
+    };
+
+    // Pop from the back of the worker's own queue (LIFO for cache warmth)
+    bool popLocal(size_t index, std::function<void()>& task) {
+        auto& q = *queues_[index];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) return false;
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    // Steal from the front of another worker's queue (FIFO to take old work)
+    bool steal(size_t selfIndex, std::function<void()>& task) {
+        for (size_t offset = 1; offset < queues_.size(); ++offset) {
+            auto& q = *queues_[(selfIndex + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(size_t index) {
+        std::function<void()> task;
+        while (true) {
+            if (popLocal(index, task) || steal(index, task)) {
+                task();
+                continue;
+            }
+            if (done_.load()) return;
+            // Nothing to run and not shutting down: sleep until new work arrives
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepCondition_.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<bool> done_{false};
+    std::atomic<size_t> nextQueue_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+};
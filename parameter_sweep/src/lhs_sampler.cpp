@@ -3,8 +3,9 @@
 #include <algorithm>
 #include <numeric>
 
-LHSSampler::LHSSampler(const std::vector<ParameterRange>& ranges, int num_samples)
-    : ranges_(ranges), num_samples_(num_samples) {
+LHSSampler::LHSSampler(const std::vector<ParameterRange>& ranges, int num_samples,
+                       uint64_t seed)
+    : ranges_(ranges), num_samples_(num_samples), seed_(seed) {
     initializePermutations();
 }
 
@@ -18,9 +19,15 @@ void LHSSampler::initializePermutations() {
             values[j] = static_cast<double>(j) / num_samples_;
         }
         
-        // Shuffle the values
-        std::random_device rd;
-        std::mt19937 rng(rd());
+        // Shuffle the values; a nonzero seed makes every dimension's
+        // permutation reproducible so all workers see the same points
+        std::mt19937_64 rng;
+        if (seed_ != 0) {
+            rng.seed(seed_ + i * 0x9E3779B97F4A7C15ull);
+        } else {
+            std::random_device rd;
+            rng.seed(rd());
+        }
         std::shuffle(values.begin(), values.end(), rng);
         
         permutations_[i] = values;
@@ -1,5 +1,8 @@
 #include "parameter_sweep.hpp"
+#include "convergence_detector.hpp"
 #include "lhs_sampler.hpp"
+#include "result_store.hpp"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -8,8 +11,11 @@
 #include <chrono>
 #include <numeric>
 #include <cmath>
-// #include <future>  // For async and future
-// #include "thread_pool.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <future>  // For async and future
+#include "thread_pool.hpp"
 
 namespace fs = std::__fs::filesystem;
 
@@ -18,158 +24,363 @@ ParameterSweep::ParameterSweep(const std::string& output_dir)
     fs::create_directories(output_dir_);
 }
 
+namespace {
+
+// Per-sample bookkeeping shared by that sample's replicate tasks. Each
+// task writes its own (rerun, sim) slot; the task that completes the
+// sample aggregates and streams the CSV line.
+struct SampleState {
+    SimulationConfig config;
+    std::vector<std::vector<double>> prey;  // [rerun][sim]
+    std::vector<std::vector<double>> pred;
+    std::vector<int> extinctSteps;          // [rerun * num_sims + sim], -1 = survived
+    std::atomic<int> remaining{0};
+    std::chrono::high_resolution_clock::time_point start;
+};
+
+// Parameter ranges every sweep (local or distributed) draws from
+const std::vector<LHSSampler::ParameterRange> kSweepRanges = {
+    {200, 800},   // NR (carrying capacity)
+    {0.5, 1.0},   // DR (death rate)
+    {0, 0.25},    // DF (predator death rate)
+    {0.25, 0.75}  // RF (predator reproduction rate)
+};
+
+// Per-sample configuration: the sampled parameters come from the store
+// record, everything else uses the sweep's fixed defaults
+SimulationConfig sampleConfig(const ResultStore::SampleRecord& rec, int num_timesteps) {
+    SimulationConfig config;
+    config.NR = static_cast<int>(rec.nr);  // Carrying capacity + FOUND THE BUG
+    config.DR = rec.dr;  // Death rate
+    config.DF = rec.df;  // Predator death rate
+    config.RF = rec.rf;  // Predator reproduction rate
+
+    // Set other parameters to default values
+    config.worldWidth = 1.0;
+    config.worldHeight = 1.0;
+    config.initialPredators = 30;
+    config.initialPrey = std::min(500, static_cast<int>(config.NR));
+    config.MF = 0.05;
+    config.MR = 0.03;
+    config.interactionRadius = 0.02;
+    config.cellSize = 0.02;
+    config.simulationSteps = num_timesteps;
+    config.randomizeInitialPositions = true;
+    config.RR = 0.1;
+    config.saveStatistics = true;
+    config.outputFile = "simulation_stats.csv";
+
+    // Stop each simulation as soon as its windowed statistics
+    // stabilize; most samples converge well before num_timesteps
+    config.earlyTermination = true;
+    return config;
+}
+
+}  // namespace
+
 void ParameterSweep::run(int num_samples, int num_reruns, int num_sims, int num_timesteps) {
     std::cout << "Starting parameter sweep..." << std::endl;
     auto start_time = std::chrono::high_resolution_clock::now();
-    std::vector<std::string> output_lines;  // Buffer for storing result lines
-
-    // Define parameter ranges for LHS
-    std::vector<LHSSampler::ParameterRange> ranges = {
-        {200, 800},  // NR (carrying capacity)
-        {0.5, 1.0},       // DR (death rate)
-        {0, 0.25},      // DF (predator death rate)
-        {0.25, 0.75}    // RF (predator reproduction rate)
-    };
-
-    // Create LHS sampler
-    LHSSampler sampler(ranges, num_samples);
-    auto samples = sampler.generateAllSamples();
 
-    // Get the number of hardware threads
-    // unsigned int num_threads = std::min(static_cast<unsigned int>(std::thread::hardware_concurrency()), static_cast<unsigned int>(num_samples));
+    // The mmapped store is the durable source of truth: completed
+    // samples survive a crash and are not re-run, and the sampled
+    // parameters are read back from it on resume (the LHS shuffle is
+    // random_device-seeded and would not regenerate the same points)
+    ResultStore store(output_dir_ + "/sweep_results.bin", num_samples);
+    if (store.resumed()) {
+        int done = 0;
+        for (int i = 0; i < num_samples; ++i) {
+            if (store.isComplete(i)) ++done;
+        }
+        std::cout << "Resuming sweep: " << done << " of " << num_samples
+                  << " samples already complete." << std::endl;
+    } else {
+        // Fresh sweep: draw the LHS points and persist them up front
+        LHSSampler sampler(kSweepRanges, num_samples);
+        auto samples = sampler.generateAllSamples();
+        for (int i = 0; i < num_samples; ++i) {
+            ResultStore::SampleRecord& rec = store.record(i);
+            rec.nr = samples[i][0];
+            rec.dr = samples[i][1];
+            rec.df = samples[i][2];
+            rec.rf = samples[i][3];
+        }
+    }
+
+    // Replicates are the unit of work: every (sample, rerun, sim) runs as
+    // its own pool task, so within-sample parallelism comes for free and
+    // small sweeps still saturate the machine
+    const int replicates_per_sample = num_reruns * num_sims;
+    unsigned int num_threads = std::min(
+        static_cast<unsigned int>(std::thread::hardware_concurrency()),
+        static_cast<unsigned int>(num_samples * replicates_per_sample));
+    if (num_threads == 0) num_threads = 1;
 
-    // Create a thread pool
-    // ThreadPool pool(num_threads);
+    ThreadPool pool(num_threads);
+    std::cout << "Running on " << num_threads << " worker threads." << std::endl;
 
-    // Enqueue tasks in the thread pool
+    std::vector<std::unique_ptr<SampleState>> states(num_samples);
     for (int i = 0; i < num_samples; ++i) {
-            auto start_time = std::chrono::high_resolution_clock::now();
-
-            // Generate sample configuration
-            SimulationConfig config;
-            config.NR = static_cast<int>(samples[i][0]);  // Carrying capacity + FOUND THE BUG
-            config.DR = samples[i][1];  // Death rate
-            config.DF = samples[i][2];  // Predator death rate
-            config.RF = samples[i][3];  // Predator reproduction rate
-
-            // Set other parameters to default values
-            config.worldWidth = 1.0;
-            config.worldHeight = 1.0;
-            config.initialPredators = 30;
-            config.initialPrey = std::min(500,static_cast<int>(config.NR));
-            config.MF = 0.05;
-            config.MR = 0.03;
-            config.interactionRadius = 0.02;
-            config.cellSize = 0.02;
-            config.simulationSteps = num_timesteps;
-            config.randomizeInitialPositions = true;
-            config.RR = 0.1;
-            config.saveStatistics = true;
-            config.outputFile = "simulation_stats.csv";
-
-            // Run single sample and get results
-            auto [avg_prey, std_prey, avg_pred, std_pred] = runSingleSample(config, num_reruns, num_sims, num_timesteps);
-            double normalized_prey = avg_prey/config.NR;
-            auto end_time = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-            std::cout << "Completed sample " << (i + 1) << " of " << num_samples 
-                      << " in " << duration.count() << " milliseconds." << std::endl;
-
-            // Format result line
-            std::stringstream line;
-            line << i << ","
-                 << config.NR << ","
-                 << config.DR << ","
-                 << config.DF << ","
-                 << config.RF << ","
-                 << avg_prey << ","
-                 << std_prey << ","
-                 << avg_pred << ","
-                 << std_pred << "," 
-                 << normalized_prey << "\n";
-
-            // Append the result line to the buffer (output_lines)
-            output_lines.push_back(line.str());
+        if (store.isComplete(i)) continue;  // finished on a previous run
+        auto state = std::make_unique<SampleState>();
+
+        // Sample configuration, from the store's persisted parameters
+        state->config = sampleConfig(store.record(i), num_timesteps);
+
+        state->prey.assign(num_reruns, std::vector<double>(num_sims, 0.0));
+        state->pred.assign(num_reruns, std::vector<double>(num_sims, 0.0));
+        state->extinctSteps.assign(replicates_per_sample, -1);
+        state->remaining.store(replicates_per_sample);
+        state->start = std::chrono::high_resolution_clock::now();
+        states[i] = std::move(state);
     }
 
-    // Wait for all tasks to finish
-    // The ThreadPool destructor will join all threads automatically
+    std::vector<std::future<void>> pending;
+    pending.reserve(static_cast<size_t>(num_samples) * replicates_per_sample);
+    std::atomic<int> completed{0};
+    std::mutex output_mutex;
 
-    // Write all results to file at once (this is done after all simulations are complete)
-    std::string filename = generateOutputFilename();
-    std::ofstream outfile(filename);
-    outfile << "sample,nr,dr,df,rf,avg_prey,std_prey,avg_predators,std_predators,normalized_prey\n";
+    for (int i = 0; i < num_samples; ++i) {
+        if (!states[i]) continue;  // already complete in the store
+        for (int rerun = 0; rerun < num_reruns; ++rerun) {
+            for (int sim = 0; sim < num_sims; ++sim) {
+                pending.push_back(pool.enqueue([this, i, rerun, sim, num_samples,
+                                                num_sims, num_timesteps, &states,
+                                                &store, &completed, &output_mutex] {
+                    SampleState& state = *states[i];
+                    auto [prey_mean, pred_mean, extinct_step] =
+                        runSingleReplicate(state.config, num_timesteps);
+                    state.prey[rerun][sim] = prey_mean;
+                    state.pred[rerun][sim] = pred_mean;
+                    state.extinctSteps[rerun * static_cast<size_t>(num_sims) + sim] = extinct_step;
+
+                    // Last replicate of the sample aggregates and publishes
+                    if (state.remaining.fetch_sub(1) != 1) {
+                        return;
+                    }
+                    auto [avg_prey, std_prey, avg_pred, std_pred] =
+                        aggregateSample(state.prey, state.pred);
+                    double normalized_prey = avg_prey / state.config.NR;
+
+                    // Extinction metrics come straight from the per-run
+                    // accumulators; -1 means no replicate went extinct
+                    int extinct_count = 0;
+                    double extinct_step_sum = 0.0;
+                    for (int step : state.extinctSteps) {
+                        if (step >= 0) {
+                            ++extinct_count;
+                            extinct_step_sum += step;
+                        }
+                    }
+                    double extinct_fraction =
+                        static_cast<double>(extinct_count) / state.extinctSteps.size();
+                    double avg_extinction_step =
+                        extinct_count > 0 ? extinct_step_sum / extinct_count : -1.0;
+                    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::high_resolution_clock::now() - state.start);
 
-    // Write the buffered results
-    for (const auto& line : output_lines) {
-        outfile << line;
+                    // Write the statistics into the mmapped record, then
+                    // flip its completion flag; a crash before the flag
+                    // lands just re-runs this sample on resume
+                    ResultStore::SampleRecord& rec = store.record(i);
+                    rec.avgPrey = avg_prey;
+                    rec.stdPrey = std_prey;
+                    rec.avgPredators = avg_pred;
+                    rec.stdPredators = std_pred;
+                    rec.normalizedPrey = normalized_prey;
+                    rec.extinctFraction = extinct_fraction;
+                    rec.avgExtinctionStep = avg_extinction_step;
+                    store.markComplete(i);
+
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cout << "Completed sample " << (completed.fetch_add(1) + 1)
+                              << " of " << num_samples << " (sample " << i << ", "
+                              << duration.count() << " milliseconds)." << std::endl;
+                }));
+            }
+        }
     }
 
-    std::cout << "Parameter sweep completed. Results saved to: " << filename << std::endl;
+    // Wait for all tasks to finish
+    for (auto& task : pending) {
+        task.get();
+    }
+
+    // Export the whole store — including samples completed on earlier
+    // runs — to the CSV schema analyze_sweep.py reads
+    std::string filename = generateOutputFilename();
+    int exported = store.exportCsv(filename);
+
+    std::cout << "Parameter sweep completed. " << exported
+              << " samples saved to: " << filename << std::endl;
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     std::cout << "Total time taken: " << duration.count() << " milliseconds" << std::endl;
 }
 
-std::tuple<double, double, double, double> ParameterSweep::runSingleSample(
+void ParameterSweep::runDistributed(int num_samples, int num_reruns, int num_sims,
+                                    int num_timesteps, uint64_t lhs_seed, int worker_id,
+                                    bool reset_claims) {
+    std::cout << "Starting distributed sweep worker " << worker_id << "..." << std::endl;
+
+    ResultStore store(output_dir_ + "/sweep_results.bin", num_samples);
+    if (reset_claims) {
+        store.resetStaleClaims();
+    }
+
+    // Every worker regenerates the identical deterministic sample set
+    // from the seed, so the points depend on neither worker count nor
+    // on which process initialized the store; persisting them from each
+    // worker is idempotent because the bytes are the same
+    LHSSampler sampler(kSweepRanges, num_samples, lhs_seed);
+    auto samples = sampler.generateAllSamples();
+    for (int i = 0; i < num_samples; ++i) {
+        if (store.isComplete(i)) continue;
+        ResultStore::SampleRecord& rec = store.record(i);
+        rec.nr = samples[i][0];
+        rec.dr = samples[i][1];
+        rec.df = samples[i][2];
+        rec.rf = samples[i][3];
+    }
+
+    unsigned int num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) num_threads = 1;
+    ThreadPool pool(num_threads);
+
+    const int replicates_per_sample = num_reruns * num_sims;
+    int claimed_count = 0;
+
+    // Dynamic load balancing: each worker pulls the next free sample as
+    // it finishes one, so the expensive corners of parameter space (high
+    // NR, low DF) cannot stall the fleet the way static sharding would
+    for (int i = 0; i < num_samples; ++i) {
+        if (!store.tryClaim(i, static_cast<uint32_t>(worker_id))) continue;
+        ++claimed_count;
+        auto sample_start = std::chrono::high_resolution_clock::now();
+
+        SimulationConfig config = sampleConfig(store.record(i), num_timesteps);
+        std::vector<std::vector<double>> prey(num_reruns, std::vector<double>(num_sims, 0.0));
+        std::vector<std::vector<double>> pred(num_reruns, std::vector<double>(num_sims, 0.0));
+        std::vector<int> extinct_steps(replicates_per_sample, -1);
+
+        // Replicates fan out across the local pool and join here
+        std::vector<std::future<void>> tasks;
+        tasks.reserve(replicates_per_sample);
+        for (int rerun = 0; rerun < num_reruns; ++rerun) {
+            for (int sim = 0; sim < num_sims; ++sim) {
+                tasks.push_back(pool.enqueue([&, rerun, sim] {
+                    auto [prey_mean, pred_mean, extinct_step] =
+                        runSingleReplicate(config, num_timesteps);
+                    prey[rerun][sim] = prey_mean;
+                    pred[rerun][sim] = pred_mean;
+                    extinct_steps[rerun * num_sims + sim] = extinct_step;
+                }));
+            }
+        }
+        for (auto& task : tasks) {
+            task.get();
+        }
+
+        auto [avg_prey, std_prey, avg_pred, std_pred] = aggregateSample(prey, pred);
+        int extinct_count = 0;
+        double extinct_step_sum = 0.0;
+        for (int step : extinct_steps) {
+            if (step >= 0) {
+                ++extinct_count;
+                extinct_step_sum += step;
+            }
+        }
+
+        ResultStore::SampleRecord& rec = store.record(i);
+        rec.avgPrey = avg_prey;
+        rec.stdPrey = std_prey;
+        rec.avgPredators = avg_pred;
+        rec.stdPredators = std_pred;
+        rec.normalizedPrey = avg_prey / config.NR;
+        rec.extinctFraction =
+            static_cast<double>(extinct_count) / replicates_per_sample;
+        rec.avgExtinctionStep =
+            extinct_count > 0 ? extinct_step_sum / extinct_count : -1.0;
+        store.markComplete(i);
+
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::high_resolution_clock::now() - sample_start);
+        std::cout << "Worker " << worker_id << " completed sample " << i
+                  << " (" << duration.count() << " milliseconds)." << std::endl;
+    }
+
+    // Whichever worker observes the store fully complete after its last
+    // claim merges the CSV; a relaunch on a finished store lets worker 0
+    // re-export without redoing any work
+    if (store.allComplete() && (claimed_count > 0 || worker_id == 0)) {
+        std::string filename = generateOutputFilename();
+        int exported = store.exportCsv(filename);
+        std::cout << "Sweep complete. " << exported
+                  << " samples exported to: " << filename << std::endl;
+    }
+    std::cout << "Worker " << worker_id << " finished after claiming "
+              << claimed_count << " samples." << std::endl;
+}
+
+std::tuple<double, double, int> ParameterSweep::runSingleReplicate(
     const SimulationConfig& config,
-    int num_reruns,
-    int num_sims,
     int num_timesteps
 ) {
+    SimulationController controller(config);
+
+    // Run simulation for specified timesteps
+    controller.initialize();
+    controller.runForTimesteps(num_timesteps);
+    controller.end();
+
+    // Means over the converged trailing window rather than the
+    // single final-step counts; the extinction step is maintained
+    // incrementally by the controller, so no history scan is needed
+    auto report = controller.getReport();
+    auto preyStats = ConvergenceDetector::windowStats(
+        report.getPreyHistory(), config.convergenceWindow);
+    auto predStats = ConvergenceDetector::windowStats(
+        report.getPredatorHistory(), config.convergenceWindow);
+    return {preyStats.mean, predStats.mean, controller.getExtinctionStep()};
+}
+
+std::tuple<double, double, double, double> ParameterSweep::aggregateSample(
+    const std::vector<std::vector<double>>& prey,
+    const std::vector<std::vector<double>>& pred
+) {
+    // Collapse each rerun's sims to a mean, as the serial version did
     std::vector<double> prey_means;
     std::vector<double> pred_means;
-    
-    // Run multiple reruns
-    for (int rerun = 0; rerun < num_reruns; ++rerun) {
-        std::vector<double> prey_counts;
-        std::vector<double> pred_counts;
-        
-        // Run multiple simulations
-        auto t1 = std::chrono::high_resolution_clock::now();
-        for (int sim = 0; sim < num_sims; ++sim) {
-            SimulationController controller(config);
-            
-            // Run simulation for specified timesteps
-            controller.initialize();
-            controller.runForTimesteps(num_timesteps);
-            controller.end();
-
-            
-            // Get final population counts
-            auto report = controller.getReport();
-            prey_counts.push_back(report.getPreyCount());
-            pred_counts.push_back(report.getPredatorCount());
-        }
-        auto t2 = std::chrono::high_resolution_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1);
-
-        // Calculate means for this rerun
-        double prey_mean = std::accumulate(prey_counts.begin(), prey_counts.end(), 0.0) / prey_counts.size();
-        double pred_mean = std::accumulate(pred_counts.begin(), pred_counts.end(), 0.0) / pred_counts.size();
-        
-        prey_means.push_back(prey_mean);
-        pred_means.push_back(pred_mean);
+    for (size_t rerun = 0; rerun < prey.size(); ++rerun) {
+        prey_means.push_back(std::accumulate(prey[rerun].begin(), prey[rerun].end(), 0.0)
+                             / prey[rerun].size());
+        pred_means.push_back(std::accumulate(pred[rerun].begin(), pred[rerun].end(), 0.0)
+                             / pred[rerun].size());
     }
 
     // Calculate overall statistics
     double prey_avg = std::accumulate(prey_means.begin(), prey_means.end(), 0.0) / prey_means.size();
     double pred_avg = std::accumulate(pred_means.begin(), pred_means.end(), 0.0) / pred_means.size();
-    
+
     // Calculate standard deviations
     double prey_std = 0.0;
     double pred_std = 0.0;
-    
+
     for (double mean : prey_means) {
         prey_std += std::pow(mean - prey_avg, 2);
     }
     for (double mean : pred_means) {
         pred_std += std::pow(mean - pred_avg, 2);
     }
-    
-    prey_std = std::sqrt(prey_std / (prey_means.size() - 1));
-    pred_std = std::sqrt(pred_std / (pred_means.size() - 1));
-    
+
+    if (prey_means.size() > 1) {
+        prey_std = std::sqrt(prey_std / (prey_means.size() - 1));
+        pred_std = std::sqrt(pred_std / (pred_means.size() - 1));
+    } else {
+        prey_std = 0.0;
+        pred_std = 0.0;
+    }
+
     return {prey_avg, prey_std, pred_avg, pred_std};
 }
 
@@ -190,6 +401,9 @@ int main(int argc, char* argv[]) {
     int num_sims = 0;
     int num_timesteps = 0;
     std::string output_dir;
+    int worker_id = -1;       // >= 0 selects the distributed worker mode
+    uint64_t lhs_seed = 0;    // required (nonzero) for distributed runs
+    bool reset_claims = false;
 
     for (int i = 1; i < argc; i += 2) {
         std::string arg = argv[i];
@@ -208,19 +422,36 @@ int main(int argc, char* argv[]) {
             num_timesteps = std::stoi(argv[i + 1]);
         } else if (arg == "--output") {
             output_dir = argv[i + 1];
+        } else if (arg == "--worker") {
+            worker_id = std::stoi(argv[i + 1]);
+        } else if (arg == "--lhs-seed") {
+            lhs_seed = std::stoull(argv[i + 1]);
+        } else if (arg == "--reset-claims") {
+            reset_claims = std::stoi(argv[i + 1]) != 0;
         }
     }
 
     // Validate arguments
     if (num_samples <= 0 || num_reruns <= 0 || num_sims <= 0 || num_timesteps <= 0 || output_dir.empty()) {
         std::cerr << "Invalid or missing arguments" << std::endl;
-        std::cerr << "Usage: " << argv[0] << " --samples N --reruns N --sims N --timesteps N --output DIR" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " --samples N --reruns N --sims N --timesteps N --output DIR"
+                  << " [--worker K --lhs-seed S [--reset-claims 1]]" << std::endl;
+        return 1;
+    }
+    if (worker_id >= 0 && lhs_seed == 0) {
+        std::cerr << "Distributed workers need --lhs-seed so every process "
+                     "derives the same sample set" << std::endl;
         return 1;
     }
 
     try {
         ParameterSweep sweep(output_dir);
-        sweep.run(num_samples, num_reruns, num_sims, num_timesteps);
+        if (worker_id >= 0) {
+            sweep.runDistributed(num_samples, num_reruns, num_sims, num_timesteps,
+                                 lhs_seed, worker_id, reset_claims);
+        } else {
+            sweep.run(num_samples, num_reruns, num_sims, num_timesteps);
+        }
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return 1;
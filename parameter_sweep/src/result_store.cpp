@@ -0,0 +1,151 @@
+#include "result_store.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kStoreMagic[8] = {'P', 'P', 'S', 'W', 'E', 'E', 'P', '1'};
+
+struct StoreHeader {
+    char magic[8];
+    uint32_t sampleCount;
+    uint32_t recordSize;
+};
+
+}  // namespace
+
+ResultStore::ResultStore(const std::string& path, int sampleCount)
+    : sampleCount(sampleCount) {
+    mappedSize = sizeof(StoreHeader) +
+                 static_cast<size_t>(sampleCount) * sizeof(SampleRecord);
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open result store: " + path);
+    }
+
+    // Serialize initialization against concurrently starting workers;
+    // exactly one process writes the fresh header, the rest adopt it
+    ::flock(fd, LOCK_EX);
+
+    // Adopt the existing file only if its header describes this sweep;
+    // anything else (empty, different sample count, old layout) starts over
+    StoreHeader header{};
+    ssize_t got = ::read(fd, &header, sizeof(header));
+    resumedFlag = got == static_cast<ssize_t>(sizeof(header)) &&
+                  std::memcmp(header.magic, kStoreMagic, sizeof(kStoreMagic)) == 0 &&
+                  header.sampleCount == static_cast<uint32_t>(sampleCount) &&
+                  header.recordSize == sizeof(SampleRecord);
+
+    if (::ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+        ::flock(fd, LOCK_UN);
+        ::close(fd);
+        throw std::runtime_error("Failed to size result store: " + path);
+    }
+
+    void* mapping = ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                           MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        ::flock(fd, LOCK_UN);
+        ::close(fd);
+        throw std::runtime_error("Failed to map result store: " + path);
+    }
+    base = static_cast<uint8_t*>(mapping);
+    records = reinterpret_cast<SampleRecord*>(base + sizeof(StoreHeader));
+
+    if (!resumedFlag) {
+        std::memset(base, 0, mappedSize);
+        StoreHeader fresh{};
+        std::memcpy(fresh.magic, kStoreMagic, sizeof(kStoreMagic));
+        fresh.sampleCount = static_cast<uint32_t>(sampleCount);
+        fresh.recordSize = sizeof(SampleRecord);
+        std::memcpy(base, &fresh, sizeof(fresh));
+    }
+    ::flock(fd, LOCK_UN);
+}
+
+ResultStore::~ResultStore() {
+    if (base) {
+        ::msync(base, mappedSize, MS_SYNC);
+        ::munmap(base, mappedSize);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void ResultStore::markComplete(int sample) {
+    // Statistics first, flag last: a crash between the two leaves the
+    // sample incomplete and it is simply re-run on resume
+    std::atomic_thread_fence(std::memory_order_release);
+    records[sample].complete = 1;
+
+    // Queue a flush of the pages the record spans; MS_ASYNC keeps the
+    // completing worker off the disk's latency path
+    const long pageSize = ::sysconf(_SC_PAGESIZE);
+    uint8_t* begin = reinterpret_cast<uint8_t*>(&records[sample]);
+    uint8_t* alignedBegin = base + ((begin - base) / pageSize) * pageSize;
+    size_t length = static_cast<size_t>(begin + sizeof(SampleRecord) - alignedBegin);
+    ::msync(alignedBegin, length, MS_ASYNC);
+}
+
+bool ResultStore::tryClaim(int sample, uint32_t workerId) {
+    if (records[sample].complete) return false;
+    uint32_t expected = 0;
+    return __atomic_compare_exchange_n(&records[sample].claimed, &expected,
+                                       workerId + 1, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+void ResultStore::resetStaleClaims() {
+    for (int i = 0; i < sampleCount; ++i) {
+        if (!records[i].complete) {
+            __atomic_store_n(&records[i].claimed, 0u, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+bool ResultStore::allComplete() const {
+    for (int i = 0; i < sampleCount; ++i) {
+        if (!records[i].complete) return false;
+    }
+    return true;
+}
+
+int ResultStore::exportCsv(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Failed to open CSV export: " + path);
+    }
+    out << "sample,nr,dr,df,rf,avg_prey,std_prey,avg_predators,std_predators,"
+           "normalized_prey,extinct_fraction,avg_extinction_step\n";
+
+    int exported = 0;
+    for (int i = 0; i < sampleCount; ++i) {
+        const SampleRecord& rec = records[i];
+        if (!rec.complete) continue;
+        out << i << ","
+            << static_cast<int>(rec.nr) << ","
+            << rec.dr << ","
+            << rec.df << ","
+            << rec.rf << ","
+            << rec.avgPrey << ","
+            << rec.stdPrey << ","
+            << rec.avgPredators << ","
+            << rec.stdPredators << ","
+            << rec.normalizedPrey << ","
+            << rec.extinctFraction << ","
+            << rec.avgExtinctionStep << "\n";
+        ++exported;
+    }
+    return exported;
+}
@@ -14,55 +14,33 @@ int Agent::getNextId() {
     return nextId_++;
 }
 
+int Agent::peekIdCounter() {
+    return nextId_.load(std::memory_order_relaxed);
+}
+
 void Agent::resetIdCounter() {
     // Simple atomic reset
     nextId_.store(0, std::memory_order_relaxed);
 }
 
-AgentAction::Action Predator::getAction(bool hasInteraction) const {
-    if (!isAlive()) return AgentAction::Action::NOTHING;
+void Agent::setIdCounter(int value) {
+    // Used by checkpoint restore so recreated agents keep their old ids
+    // and newly born agents continue from the saved counter
+    nextId_.store(value, std::memory_order_relaxed);
+}
 
-    const auto& config = context.getConfig();
+// The action logic lives in AgentTraits so the monomorphic stepping
+// kernels can inline it; the virtual overrides only add the liveness guard
 
-    // Handle predation and reproduction
-    if (hasInteraction) {
-        // Try to reproduce
-        std::uniform_real_distribution<double> reproDist(0.0, 1.0);
-        if (reproDist(context.getRNG()) < config.RF) {
-            // Create new predator at current position
-            return AgentAction::Action::REPRODUCE;
-        }
-    } else {
-        // Risk of death when no prey around
-        std::uniform_real_distribution<double> deathDist(0.0, 1.0);
-        if (deathDist(context.getRNG()) < config.DF) {
-            return AgentAction::Action::DIE;
-        }
-    }
-    return AgentAction::Action::NOTHING;
-    
+AgentAction::Action Predator::getAction(bool hasInteraction) const {
+    if (!isAlive()) return AgentAction::Action::NOTHING;
+    return AgentTraits<Predator>::decide(hasInteraction, context.getRNG(),
+                                         context.getConfig(), context.getPreyCount());
 }
 
 AgentAction::Action Prey::getAction(bool hasInteraction) const {
     if (!isAlive()) return AgentAction::Action::NOTHING;
-    const auto& config = context.getConfig();
-
-    // Handle predation and reproduction
-    if (hasInteraction) {
-        // Risk of being eaten
-        std::uniform_real_distribution<double> deathDist(0.0, 1.0);
-        if (deathDist(context.getRNG()) < config.DR) {
-            return AgentAction::Action::DIE;
-        }
-    } 
-
-    // Try to reproduce if below carrying capacity
-    std::uniform_real_distribution<double> reproDist(0.0, 1.0);
-    if (reproDist(context.getRNG()) < config.RR * (1 - static_cast<double>(context.getPreyCount()) / static_cast<double>(config.NR))) {
-        // Create new prey at current position
-        return AgentAction::Action::REPRODUCE;
-    }
-    
-    return AgentAction::Action::NOTHING;
+    return AgentTraits<Prey>::decide(hasInteraction, context.getRNG(),
+                                     context.getConfig(), context.getPreyCount());
 }
   
\ No newline at end of file
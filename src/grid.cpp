@@ -3,23 +3,39 @@
 
 // Grid implementation
 Grid::Grid(double cellSize, double worldWidth, double worldHeight)
-    : spatialGrid(worldWidth, worldHeight, cellSize),
+    : spatialGrid(worldWidth, worldHeight, cellSize, store),
       cellSize(cellSize),
       worldWidth(worldWidth),
       worldHeight(worldHeight) {
     // Reserve space for expected agent counts
+    store.reserve(6000);
     predators.reserve(1000);
     preys.reserve(5000);
 }
 
 void Grid::addAgent(std::shared_ptr<Agent> agent) {
+    AgentHandle handle = store.add(agent);
+    agent->setHandle(handle);
+
     if (agent->getType() == Agent::PREDATOR) {
-        predators.add(std::static_pointer_cast<Predator>(agent));
+        predators.add(agent->getId(), handle);
     } else {
-        preys.add(std::static_pointer_cast<Prey>(agent));
+        preys.add(agent->getId(), handle);
+    }
+
+    // Register in the persistent iteration order
+    if (handle >= orderIndex.size()) {
+        orderIndex.resize(handle + 1, UINT32_MAX);
     }
-    
-    spatialGrid.insert(agent);
+    // A recycled slot must not inherit its previous occupant's cooldown
+    if (handle >= interactionCooldowns.size()) {
+        interactionCooldowns.resize(handle + 1, 0);
+    }
+    interactionCooldowns[handle] = 0;
+    orderIndex[handle] = static_cast<uint32_t>(iterationOrder.size());
+    iterationOrder.push_back(handle);
+
+    spatialGrid.insert(handle);
 }
 
 void Grid::removeAgent(const std::shared_ptr<Agent>& agent) {
@@ -29,57 +45,160 @@ void Grid::removeAgent(const std::shared_ptr<Agent>& agent) {
     } else {
         preys.remove(agent->getId());
     }
-    
-    // Remove from spatial grid
-    spatialGrid.remove(agent);
+
+    // Remove from spatial grid, then free the store slot; the stale
+    // iteration-order entry is compacted away before the next pass
+    spatialGrid.remove(agent->getHandle());
+    store.remove(agent->getHandle());
+    orderDirty = true;
+    agent->setHandle(InvalidAgentHandle);
 }
 
 
-const std::vector<std::shared_ptr<Predator>>& Grid::getPredators() const {
+const std::vector<AgentHandle>& Grid::getPredators() const {
     return predators.getAll();
 }
 
-const std::vector<std::shared_ptr<Prey>>& Grid::getPreys() const {
+const std::vector<AgentHandle>& Grid::getPreys() const {
     return preys.getAll();
 }
 
 std::vector<std::shared_ptr<Agent>> Grid::getAgents() const {
     std::vector<std::shared_ptr<Agent>> allAgents;
     allAgents.reserve(predators.size() + preys.size());
-    
+
     // Copy predators
-    const auto& predatorList = predators.getAll();
-    allAgents.insert(allAgents.end(), predatorList.begin(), predatorList.end());
-    
+    for (AgentHandle handle : predators.getAll()) {
+        allAgents.push_back(store.get(handle));
+    }
+
     // Copy prey
-    const auto& preyList = preys.getAll();
-    allAgents.insert(allAgents.end(), preyList.begin(), preyList.end());
-    
+    for (AgentHandle handle : preys.getAll()) {
+        allAgents.push_back(store.get(handle));
+    }
+
     return allAgents;
 }
 
+void Grid::queueAgentAddition(std::shared_ptr<Agent> agent) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingAdditions.push_back(std::move(agent));
+}
+
+void Grid::queueAgentRemoval(std::shared_ptr<Agent> agent) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingRemovals.push_back(std::move(agent));
+}
+
+void Grid::queueAgentMove(std::shared_ptr<Agent> agent, const Position& oldPos) {
+    std::lock_guard<std::mutex> lock(pendingMutex);
+    pendingMoves.emplace_back(std::move(agent), oldPos);
+}
+
+void Grid::applyPendingChanges() {
+    // Single-threaded: workers have been joined before this runs.
+    // Moves first so later removals see each handle in its current cell
+    for (auto& [agent, oldPos] : pendingMoves) {
+        if (agent->getHandle() == InvalidAgentHandle) continue;
+        store.setPosition(agent->getHandle(), agent->getPosition());
+        spatialGrid.updatePosition(agent->getHandle(), oldPos);
+    }
+    pendingMoves.clear();
+
+    for (auto& agent : pendingAdditions) {
+        addAgent(std::move(agent));
+    }
+    pendingAdditions.clear();
+
+    for (auto& agent : pendingRemovals) {
+        removeAgent(agent);
+    }
+    pendingRemovals.clear();
+}
+
+void Grid::applyMoves(const std::vector<AgentHandle>& handles,
+                      const std::vector<Position>& newPositions) {
+    if (spatialGrid.isRebuildMode()) {
+        // Position writes only; one counting-sort rebuild rebuckets all
+        for (size_t i = 0; i < handles.size(); ++i) {
+            AgentHandle handle = handles[i];
+            if (auto agent = store.get(handle)) {
+                agent->setPosition(newPositions[i]);
+            }
+            store.setPosition(handle, newPositions[i]);
+        }
+        spatialGrid.rebuild();
+        return;
+    }
+
+    for (size_t i = 0; i < handles.size(); ++i) {
+        AgentHandle handle = handles[i];
+        Position oldPos = store.position(handle);
+        if (auto agent = store.get(handle)) {
+            agent->setPosition(newPositions[i]);
+        }
+        store.setPosition(handle, newPositions[i]);
+        spatialGrid.updatePosition(handle, oldPos);
+    }
+}
+
 bool Grid::hasOppositeTypeNeighbor(const std::shared_ptr<Agent>& agent, double radius) {
-    return spatialGrid.hasOppositeTypeNeighbor(agent, radius);
+    return spatialGrid.hasOppositeTypeNeighbor(agent->getHandle(), radius);
+}
+
+bool Grid::hasOppositeTypeNeighborAt(const std::shared_ptr<Agent>& agent,
+                                     const Position& pos, double radius) {
+    return spatialGrid.hasOppositeTypeNeighbor(agent->getHandle(), pos, radius);
 }
 
 std::vector<std::shared_ptr<Agent>> Grid::getNearbyAgents(const Position& pos, double radius) {
-    return spatialGrid.getNeighbors(pos, radius);
+    std::vector<AgentHandle> handles = spatialGrid.getNeighbors(pos, radius);
+    std::vector<std::shared_ptr<Agent>> agents;
+    agents.reserve(handles.size());
+    for (AgentHandle handle : handles) {
+        agents.push_back(store.get(handle));
+    }
+    return agents;
 }
 
 std::vector<std::shared_ptr<Agent>> Grid::getNearbyAgentsOfType(
         const Position& pos, double radius, Agent::Type type) {
-    return spatialGrid.getNeighborsOfType(pos, radius, type);
+    std::vector<AgentHandle> handles = spatialGrid.getNeighborsOfType(pos, radius, type);
+    std::vector<std::shared_ptr<Agent>> agents;
+    agents.reserve(handles.size());
+    for (AgentHandle handle : handles) {
+        agents.push_back(store.get(handle));
+    }
+    return agents;
+}
+
+void Grid::getNearbyAgents(const Position& pos, double radius,
+                           std::vector<AgentHandle>& out) {
+    spatialGrid.getNeighbors(pos, radius, out);
+}
+
+void Grid::getNearbyAgentsOfType(const Position& pos, double radius, Agent::Type type,
+                                 std::vector<AgentHandle>& out) {
+    spatialGrid.getNeighborsOfType(pos, radius, type, out);
 }
 
-void Grid::moveAgent(const std::shared_ptr<Agent>& agent, 
+void Grid::moveAgent(const std::shared_ptr<Agent>& agent,
                      const Position& oldPos, const Position& newPos) {
-    spatialGrid.updatePosition(agent, oldPos);
+    // Write the new coordinates through to the store's parallel arrays,
+    // then rebucket the handle in the spatial index
+    store.setPosition(agent->getHandle(), newPos);
+    spatialGrid.updatePosition(agent->getHandle(), oldPos);
 }
 
 void Grid::clearAll() {
     predators.clear();
     preys.clear();
     spatialGrid.clear();
+    store.clear();
+    iterationOrder.clear();
+    orderIndex.clear();
+    interactionCooldowns.clear();
+    orderDirty = false;
 }
 
 size_t Grid::size() const {
@@ -0,0 +1,94 @@
+#include "live_viewer.hpp"
+#include "agent.hpp"
+#include <SFML/Graphics.hpp>
+#include <string>
+
+// SFML rendering for the live view. Like simulation_report.cpp this is
+// the only place live-view data touches the graphics stack; it is
+// compiled into the predator_prey_viz target so headless builds skip it.
+
+namespace {
+
+constexpr unsigned int WINDOW_WIDTH = 800;
+constexpr unsigned int WINDOW_HEIGHT = 800;
+constexpr float MARGIN = 20.f;
+
+sf::Vector2f mapToScreen(float x, float y) {
+    float screenX = MARGIN + x * (WINDOW_WIDTH - 2 * MARGIN);
+    float screenY = WINDOW_HEIGHT - MARGIN - y * (WINDOW_HEIGHT - 2 * MARGIN);
+    return sf::Vector2f(screenX, screenY);
+}
+
+void drawAgents(sf::RenderWindow& window, const LiveViewBuffer::Frame& frame) {
+    if (frame.xs.empty()) return;
+
+    // One vertex per agent; points keep the draw cost flat even with
+    // tens of thousands of agents on screen
+    sf::VertexArray points(sf::PrimitiveType::Points, frame.xs.size());
+    for (size_t i = 0; i < frame.xs.size(); ++i) {
+        points[i].position = mapToScreen(frame.xs[i], frame.ys[i]);
+        points[i].color = frame.types[i] == Agent::PREDATOR ? sf::Color::Red
+                                                            : sf::Color::Blue;
+    }
+    window.draw(points);
+}
+
+// Counts go in the title bar, which needs no font loading
+std::string frameTitle(const LiveViewBuffer::Frame& frame) {
+    return "Live Simulation - step " + std::to_string(frame.step) +
+           " | predators " + std::to_string(frame.predators) +
+           " | prey " + std::to_string(frame.prey);
+}
+
+}  // namespace
+
+LiveViewer::LiveViewer(std::shared_ptr<LiveViewBuffer> buffer,
+                       unsigned int frameRate)
+    : buffer(std::move(buffer)), frameRate(frameRate) {}
+
+LiveViewer::~LiveViewer() {
+    stop();
+}
+
+void LiveViewer::start() {
+    if (running.exchange(true)) return;
+    renderThread = std::thread([this] { renderLoop(); });
+}
+
+void LiveViewer::stop() {
+    running.store(false);
+    if (renderThread.joinable()) {
+        renderThread.join();
+    }
+}
+
+void LiveViewer::renderLoop() {
+    sf::RenderWindow window(sf::VideoMode(sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT)), "Live Simulation");
+    window.setFramerateLimit(frameRate);
+
+    // Local copy of the last frame shown, so the view persists across
+    // ticks where the simulation published nothing new
+    LiveViewBuffer::Frame current;
+
+    while (running.load(std::memory_order_relaxed) && window.isOpen()) {
+        if (const auto event = window.pollEvent()) {
+            if (event->is<sf::Event::Closed>()) {
+                window.close();
+            }
+        }
+
+        // Jump to the newest committed frame; older backlog is released
+        // unseen, which is what keeps a slow viewer from mattering
+        if (const LiveViewBuffer::Frame* latest = buffer->acquireLatest()) {
+            current = *latest;
+            buffer->releaseLatest();
+            window.setTitle(frameTitle(current));
+        }
+
+        window.clear(sf::Color::White);
+        drawAgents(window, current);
+        window.display();
+    }
+
+    running.store(false);
+}
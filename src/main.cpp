@@ -39,6 +39,8 @@ void printReport(const SimulationReport& report) {
     std::cout << "  Reproduction Rate of Predator: " << report.getSimulationConfig().RF << "\n";
     std::cout << "  Save Statistics: " << (report.getSimulationConfig().saveStatistics ? "Yes" : "No") << "\n";
     std::cout << "  Output File: " << report.getSimulationConfig().outputFile << "\n";
+    std::cout << "\nInstrumentation:\n";
+    std::cout << "  " << report.instrumentationJson() << "\n";
     std::cout << "=========================\n";
 }
 
@@ -1,5 +1,6 @@
 #include "simulation_controller.hpp"
 #include "agent.hpp"
+#include "convergence_detector.hpp"
 #include "simulation_context.hpp"
 #include "simulation_report.hpp"
 #include "grid.hpp"
@@ -11,43 +12,133 @@
 #include <algorithm>
 #include <cmath>
 #include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
-std::mt19937 SimulationController::rng(std::random_device{}());
-std::uniform_real_distribution<double> SimulationController::reproDist(0, 1);
-std::uniform_real_distribution<double> SimulationController::deathDist(0, 1);
+namespace {
 
+// Serialization helpers for the binary checkpoint image
+template <typename T>
+void appendRaw(std::vector<uint8_t>& buffer, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool readRaw(const std::vector<uint8_t>& buffer, size_t& offset, T& value) {
+    if (offset + sizeof(T) > buffer.size()) return false;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+// Version 02: the agent table is written in iteration order rather than
+// slot order, so a restored run replays the original's update sequence
+constexpr char kCheckpointMagic[8] = {'P', 'P', 'C', 'K', 'P', 'T', '0', '2'};
+
+// Cell size for an expected population: never below interactionRadius
+// (keeps the query window at 3x3 cells), and above that sized so cells
+// average about four agents instead of overflowing or sitting empty
+double tunedCellSize(const SimulationConfig& config, int expectedAgents) {
+    constexpr double targetPerCell = 4.0;
+    double area = config.worldWidth * config.worldHeight;
+    double densitySize = std::sqrt(area * targetPerCell / std::max(expectedAgents, 1));
+    double maxSize = std::min(config.worldWidth, config.worldHeight) / 4.0;
+    return std::clamp(densitySize, config.interactionRadius, maxSize);
+}
+
+// Mean-field fast path thresholds: how many consecutive steps without a
+// single predator-prey interaction (with prey near capacity) before the
+// run is treated as quasi-deterministic, and how many mean-field steps
+// pass between probe steps through the real agent machinery
+constexpr int kQuietStepsToEnterMeanField = 32;
+constexpr int kMeanFieldProbeInterval = 64;
+
+// Steps of interaction checks a successful clearance probe covers: the
+// nearest opposite-type agent starts at least sparseClearanceRadius
+// away, both parties close by at most one step length per step, and one
+// extra opposite-type move covers agents not yet stepped when the probe
+// ran. Non-positive means the probe cannot cover even one step and
+// sparse checking is a no-op.
+int clearanceSteps(const SimulationConfig& config) {
+    const double maxStep = std::max(config.MF, config.MR);
+    if (maxStep <= 0.0) return 0;
+    return static_cast<int>(std::floor(
+        (config.sparseClearanceRadius - config.interactionRadius - maxStep) /
+        (2.0 * maxStep)));
+}
 
+}  // namespace
 
 // Helper function to generate random positionå
 Position SimulationController::randomPosition() {
-    std::mt19937& rng = SimulationController::rng;
-    return Position{SimulationController::reproDist(rng), SimulationController::reproDist(rng)};
+    CounterRNG& rng = context.getRNG();
+    return Position{rng.uniform01(), rng.uniform01()};
 }
 
 Position SimulationController::randomDirection() {
-    std::mt19937& rng = SimulationController::rng;
-    double x = 2*SimulationController::reproDist(rng)-1;
-    double y = 2*SimulationController::reproDist(rng)-1;
+    CounterRNG& rng = context.getRNG();
+    double x = 2*rng.uniform01()-1;
+    double y = 2*rng.uniform01()-1;
     return Position{x, y};
 }
 
+// Keeps a moved position inside the world: clamped to the walls in the
+// default closed world, wrapped around in toroidal mode
+Position SimulationController::confinePosition(Position pos) const {
+    if (context.getConfig().toroidalWorld) {
+        return pos.wrappedUnit();
+    }
+    pos.x = std::clamp(pos.x, 0.0, 1.0);
+    pos.y = std::clamp(pos.y, 0.0, 1.0);
+    return pos;
+}
+
+// The interaction test behind the sequential and typed stepping paths,
+// with the sparse-stepping shortcut: an active cooldown answers false
+// without searching, and a miss tries to earn a new cooldown by proving
+// the surrounding clearance radius empty of opposite-type agents.
+// Movement is untouched, so the dynamics are identical either way.
+bool SimulationController::interactionCheck(const std::shared_ptr<Agent>& agent) {
+    const SimulationConfig& config = context.getConfig();
+    if (config.sparseInteractionChecks &&
+        grid.consumeInteractionCooldown(agent->getHandle())) {
+        return false;
+    }
+
+    instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kNeighborQuery);
+    if (grid.hasOppositeTypeNeighbor(agent, config.interactionRadius)) {
+        return true;
+    }
+    if (config.sparseInteractionChecks) {
+        const int steps = clearanceSteps(config);
+        if (steps > 0 &&
+            !grid.hasOppositeTypeNeighbor(agent, config.sparseClearanceRadius)) {
+            grid.setInteractionCooldown(agent->getHandle(), steps);
+        }
+    }
+    return false;
+}
+
 
 SimulationController::SimulationController(const SimulationConfig& config)
-    : context(config),
-      grid(config.cellSize),
-      predatorHistory(config.simulationSteps, 0),
-      preyHistory(config.simulationSteps, 0){}
+    : configStorage(config),
+      context(configStorage),
+      grid(config.cellSize) {
+    // One upfront reservation; updateHistory never reallocates after this
+    predatorHistory.reserve(config.simulationSteps + 1);
+    preyHistory.reserve(config.simulationSteps + 1);
+}
 
 
 int SimulationController::agentCount() const{
     return predatorCount + preyCount;
 }
 
-size_t SimulationController::randomAgentIndex() const {
-    std::random_device rd;
-    std::mt19937 rng(rd());
+size_t SimulationController::randomAgentIndex() {
     std::uniform_int_distribution<size_t> dist(0, agentCount() - 1);
-    return dist(rng);
+    return dist(context.getRNG());
 }
 
 void SimulationController::initializePopulation() {
@@ -57,7 +148,7 @@ void SimulationController::initializePopulation() {
     // Add initial prey
     for (int i = 0; i < config.initialPrey; ++i) {
         Position pos = randomPosition();
-        auto prey = std::make_shared<Prey>(pos, context);
+        auto prey = agentPool.makePrey(pos, context);
         grid.addAgent(prey);
         preyCount++;
     }
@@ -65,15 +156,24 @@ void SimulationController::initializePopulation() {
     // Add initial predators
     for (int i = 0; i < config.initialPredators; ++i) {
         Position pos = randomPosition();
-        auto predator = std::make_shared<Predator>(pos, context);
+        auto predator = agentPool.makePredator(pos, context);
         grid.addAgent(predator);
         predatorCount++;
     }
 }
 
 void SimulationController::updateHistory() {
-    predatorHistory.push_back(getCurrentPredatorCount());
-    preyHistory.push_back(getCurrentPreyCount());
+    int predators = getCurrentPredatorCount();
+    int prey = getCurrentPreyCount();
+    predatorHistory.push_back(predators);
+    preyHistory.push_back(prey);
+    predatorStats.add(predators);
+    preyStats.add(prey);
+    predatorSeries.add(predators);
+    preySeries.add(prey);
+    if (extinctionStep < 0 && predators == 0) {
+        extinctionStep = currentStep;
+    }
 }
 
 void SimulationController::initialize() {
@@ -83,49 +183,581 @@ void SimulationController::initialize() {
     startTime = std::chrono::steady_clock::now();
     predatorHistory.clear();
     preyHistory.clear();
-    
+    predatorStats.reset();
+    preyStats.reset();
+    predatorSeries.reset();
+    preySeries.reset();
+    extinctionStep = -1;
+    meanFieldDecayActive = false;
+    quietPredatorSteps = 0;
+    meanFieldDeathDebt = 0.0;
+    predatorInteractedThisStep.store(false, std::memory_order_relaxed);
+    stepMetrics.reset();
+    grid.resetSpatialQueryCounters();
+
+    // Sparse checks need a clearance radius wide enough to cover several
+    // steps beyond the closing speed: each successful probe costs one
+    // wide query, so covering a single step only breaks even. Derive the
+    // default from the movement scale to cover three, and call out an
+    // explicit radius that cannot cover any step — the probe would never
+    // grant a cooldown and the flag would be a silent no-op
+    if (configStorage.sparseInteractionChecks) {
+        if (configStorage.sparseClearanceRadius <= 0.0) {
+            configStorage.sparseClearanceRadius =
+                configStorage.interactionRadius +
+                7.0 * std::max(configStorage.MF, configStorage.MR);
+        }
+        if (clearanceSteps(configStorage) <= 0) {
+            std::cerr << "sparseInteractionChecks enabled, but sparseClearanceRadius "
+                      << configStorage.sparseClearanceRadius
+                      << " covers no steps at this movement scale; "
+                      << "sparse checking is inactive" << std::endl;
+        }
+    }
+
+    // Rebuild mode turns per-move index maintenance into no-ops, but the
+    // tiled path iterates live cells and commits moves at every color
+    // phase -- combined, every step would query the step-0 cell layout
+    // forever. Fall back to per-move maintenance.
+    if (configStorage.parallelStepping && configStorage.spatialRebuild) {
+        std::cerr << "spatialRebuild is not supported with parallelStepping; "
+                  << "falling back to per-move index maintenance" << std::endl;
+        configStorage.spatialRebuild = false;
+    }
+
     // Clear grid before resetting counters
     grid.clearAll();
     setPredatorCount(0);
     setPreyCount(0);
-    
+
+    // Pick the cell size from the expected density while the grid is
+    // still empty, so no re-bucketing pass is needed
+    if (context.getConfig().autoTuneCellSize) {
+        int expected = context.getConfig().NR + context.getConfig().initialPredators;
+        grid.setCellSize(tunedCellSize(context.getConfig(), expected));
+    }
+
     initializePopulation();
     updateHistory();
 
+    grid.setSpatialRebuildMode(context.getConfig().spatialRebuild);
+    if (grid.spatialRebuildEnabled()) {
+        grid.rebuildSpatialIndex();
+    }
+
+    grid.setTorusMode(context.getConfig().toroidalWorld);
+
+    if (grid.isQuantizedPositions() != context.getConfig().quantizedPositions) {
+        grid.setQuantizedPositions(context.getConfig().quantizedPositions);
+    }
+
+    // Let co-located agents share opposite-type candidate summaries; the
+    // cache is not safe under concurrent tile workers and cannot express
+    // wrapped candidate copies, so parallel stepping and the toroidal
+    // world leave it off
+    grid.setSummaryCache(!context.getConfig().parallelStepping &&
+                         !context.getConfig().toroidalWorld);
+
+    if (context.getConfig().recordTrajectory && !trajectoryRecorder) {
+        enableTrajectoryRecording(context.getConfig().trajectoryFile);
+    }
+    if (trajectoryRecorder) {
+        trajectoryRecorder->recordStep(0, grid.getStore());
+    }
+
+    // Spin up the tile worker pool on first use when parallel stepping is on
+    if (context.getConfig().parallelStepping && !stepPool) {
+        unsigned int numThreads = context.getConfig().stepThreads > 0
+            ? static_cast<unsigned int>(context.getConfig().stepThreads)
+            : std::thread::hardware_concurrency();
+        stepPool = std::make_unique<ThreadPool>(numThreads ? numThreads : 1);
+    }
+
     // Agent::resetIdCounter();
 }
 
+void SimulationController::reset(const SimulationConfig& config) {
+    configStorage = config;
+    context.reset(SimulationContext::drawSeed(configStorage));
+
+    // Re-bucket only if the cell geometry actually changed; initialize()
+    // handles the auto-tuned case itself
+    if (!configStorage.autoTuneCellSize &&
+        grid.getCellSize() != configStorage.cellSize) {
+        grid.setCellSize(configStorage.cellSize);
+    }
+
+    // getReport() moves the histories out, so re-reserve; a no-op when
+    // the previous run's capacity is still in place
+    predatorHistory.reserve(configStorage.simulationSteps + 1);
+    preyHistory.reserve(configStorage.simulationSteps + 1);
+
+    initialize();
+}
+
+void SimulationController::maybeRetuneCellSize() {
+    const SimulationConfig& config = context.getConfig();
+    if (!config.autoTuneCellSize || currentStep == 0 || currentStep % 256 != 0) {
+        return;
+    }
+    // Re-bucket only on clear density drift; the rebuild is not worth it
+    // for small oscillations around the tuned size
+    double ideal = tunedCellSize(config, agentCount());
+    double current = grid.getCellSize();
+    if (ideal > current * 1.5 || ideal < current / 1.5) {
+        grid.setCellSize(ideal);
+    }
+}
+
+void SimulationController::finalizeStep() {
+    noteStepInteractions();
+    currentStep++;
+    updateHistory();
+    if (trajectoryRecorder) {
+        trajectoryRecorder->recordStep(static_cast<uint32_t>(currentStep), grid.getStore());
+    }
+    if (liveViewBuffer && currentStep % liveViewInterval == 0) {
+        publishLiveFrame();
+    }
+}
+
+void SimulationController::noteStepInteractions() {
+    bool interacted = predatorInteractedThisStep.exchange(false, std::memory_order_relaxed);
+    const SimulationConfig& config = context.getConfig();
+    if (!config.meanFieldFastPath || !config.meanFieldDecayApprox ||
+        meanFieldDecayActive) {
+        return;
+    }
+    // The decay regime needs predators alive, prey within 5% of the
+    // carrying capacity and no predator finding prey this step
+    bool quiet = !interacted && getCurrentPredatorCount() > 0 &&
+                 getCurrentPreyCount() * 20 >= config.NR * 19;
+    if (!quiet) {
+        quietPredatorSteps = 0;
+        return;
+    }
+    if (++quietPredatorSteps >= kQuietStepsToEnterMeanField) {
+        meanFieldDecayActive = true;
+        meanFieldProbeCountdown = kMeanFieldProbeInterval;
+        meanFieldDeathDebt = 0.0;
+    }
+}
+
+bool SimulationController::updateMeanField() {
+    const SimulationConfig& config = context.getConfig();
+
+    // Absorbed regime: with predators extinct nothing stochastic is left;
+    // prey sits at the carrying capacity forever. Exact, and there is no
+    // exit, so the agent machinery is never touched again.
+    if (getCurrentPredatorCount() == 0) {
+        setPreyCount(config.NR);
+        finalizeStep();
+        return true;
+    }
+
+    if (!meanFieldDecayActive) {
+        return false;
+    }
+
+    // Hand one step back to the agent machinery periodically to verify
+    // the regime still holds; a quiet probe re-enters within one step
+    // via noteStepInteractions, an interaction keeps us agent-based
+    if (--meanFieldProbeCountdown <= 0) {
+        meanFieldDecayActive = false;
+        quietPredatorSteps = kQuietStepsToEnterMeanField - 1;
+        return false;
+    }
+
+    // Quasi-deterministic decay: prey pinned at capacity, predators
+    // starving and dying at rate DF. Evolve the expected count, carrying
+    // the fractional remainder across steps, and retire whole agents
+    // from the grid so a fall-back resumes from a truthful agent state.
+    // Which predator dies is immaterial here — only counts evolve.
+    meanFieldDeathDebt += getCurrentPredatorCount() * config.DF;
+    int deaths = static_cast<int>(meanFieldDeathDebt);
+    meanFieldDeathDebt -= deaths;
+    for (int i = 0; i < deaths; ++i) {
+        const auto& handles = grid.getPredators();
+        if (handles.empty()) break;
+        auto agent = grid.getStore().get(handles.back());
+        agent->die();
+        grid.removeAgent(agent);
+        decrementPredatorCount();
+    }
+    setPreyCount(config.NR);
+    finalizeStep();
+    return true;
+}
+
 void SimulationController::updateSingleTimestep() {
-    // Get all agents from grid - make a copy to avoid concurrent modification issues
-    auto agents = grid.getAgents();
-    int agentCount = agents.size();
-    
-    // Create a vector of indices and shuffle it for randomized updates
-    std::vector<size_t> indices(agentCount);
-    for (size_t i = 0; i < agentCount; ++i) {
-        indices[i] = i;
+    if (context.getConfig().meanFieldFastPath && updateMeanField()) {
+        return;
     }
-    std::shuffle(indices.begin(), indices.end(), SimulationController::rng);
-    
-    // Process agents in random order
-    for (size_t i = 0; i < agentCount; ++i) {
-        if(getCurrentPredatorCount() == 0){
+
+    maybeRetuneCellSize();
+
+    if (context.getConfig().parallelStepping && stepPool) {
+        updateSingleTimestepParallel();
+        return;
+    }
+    if (context.getConfig().batchedStepping) {
+        updateSingleTimestepBatched();
+        return;
+    }
+    if (context.getConfig().typedStepping) {
+        updateSingleTimestepTyped();
+        return;
+    }
+
+    // In rebuild mode, re-bucket the whole population in two linear passes
+    // instead of paying per-move cell maintenance during the step
+    if (grid.spatialRebuildEnabled()) {
+        grid.rebuildSpatialIndex();
+    }
+
+    // Process agents in random order over the grid's persistent iteration
+    // order; no per-step agent vector or index vector is materialized.
+    // The shuffle is split out so it lands in its own timing bucket.
+    {
+        instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kShuffle);
+        grid.shuffleIterationOrder(context.getRNG());
+    }
+    grid.forEachAgentInOrder([this](const std::shared_ptr<Agent>& agent) {
+        if (getCurrentPredatorCount() == 0) {
             setPreyCount(context.getConfig().NR);
+            return false;
+        }
+        if (agent && agent->isAlive()) {
+            updateSingleAgent(agent);
+        }
+        return true;
+    });
+
+    finalizeStep();
+}
+
+
+// One monomorphic pass over a single agent type. The traits calls
+// resolve statically, so getAction devirtualizes and the movement
+// magnitude and rate parameters stay hoisted out of the loop; each
+// pass is shuffled to keep within-type update order unbiased.
+template <typename AgentType>
+void SimulationController::stepAgents() {
+    const SimulationConfig& config = context.getConfig();
+    const AgentStore& store = grid.getStore();
+    const double magnitude = AgentTraits<AgentType>::moveMagnitude(config);
+    constexpr bool isPredator = AgentTraits<AgentType>::type == Agent::PREDATOR;
+
+    // Snapshot the typed handle list: births append to the container
+    // during the pass and must first step next timestep, and deaths
+    // swap-and-pop it under our feet
+    static thread_local std::vector<AgentHandle> pass;
+    {
+        instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kShuffle);
+        pass = isPredator ? grid.getPredators() : grid.getPreys();
+        std::shuffle(pass.begin(), pass.end(), context.getRNG());
+    }
+
+    for (AgentHandle handle : pass) {
+        if (getCurrentPredatorCount() == 0) {
+            setPreyCount(config.NR);
+            return;
+        }
+        if (!store.isAlive(handle)) continue;
+        auto agent = store.get(handle);
+        if (!agent || !agent->isAlive()) continue;
+
+        Position oldPosition = agent->getPosition();
+        Position newPosition = oldPosition;
+        {
+            instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kMovement);
+            newPosition = confinePosition(oldPosition + randomDirection() * magnitude);
+            agent->setPosition(newPosition);
+        }
+        {
+            instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kMoveAgent);
+            grid.moveAgent(agent, oldPosition, newPosition);
+        }
+
+        bool hasInteraction = interactionCheck(agent);
+        if (isPredator && hasInteraction) {
+            predatorInteractedThisStep.store(true, std::memory_order_relaxed);
+        }
+
+        AgentAction::Action action;
+        {
+            instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kAction);
+            action = AgentTraits<AgentType>::decide(
+                hasInteraction, context.getRNG(), config, getCurrentPreyCount());
+        }
+        instrumentation::ScopedTimer birthsDeathsTimer(stepMetrics,
+                                                       instrumentation::kBirthsDeaths);
+        if (action == AgentAction::Action::REPRODUCE) {
+            if (isPredator) {
+                grid.addAgent(agentPool.makePredator(newPosition, context));
+                incrementPredatorCount();
+            } else if (getCurrentPreyCount() < config.NR) {
+                grid.addAgent(agentPool.makePrey(newPosition, context));
+                incrementPreyCount();
+            }
+        } else if (action == AgentAction::Action::DIE) {
+            agent->die();
+            grid.removeAgent(agent);
+            if (isPredator) {
+                decrementPredatorCount();
+            } else {
+                decrementPreyCount();
+            }
+        }
+    }
+}
+
+void SimulationController::updateSingleTimestepTyped() {
+    if (grid.spatialRebuildEnabled()) {
+        grid.rebuildSpatialIndex();
+    }
+
+    // All prey first, then all predators; within-type order is shuffled
+    stepAgents<Prey>();
+    stepAgents<Predator>();
+
+    finalizeStep();
+}
+
+void SimulationController::updateSingleTimestepBatched() {
+    const SimulationConfig& config = context.getConfig();
+    const AgentStore& store = grid.getStore();
+
+    // Phase 1: generate every agent's move in one tight pass over the
+    // store's contiguous arrays; nothing is committed yet
+    static thread_local std::vector<AgentHandle> moveHandles;
+    static thread_local std::vector<Position> movePositions;
+    moveHandles.clear();
+    movePositions.clear();
+
+    const size_t slots = store.capacity();
+    const uint8_t* alive = store.aliveData();
+    const uint8_t* types = store.typeData();
+    const double* xs = store.xData();
+    const double* ys = store.yData();
+    {
+        instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kMovement);
+        for (size_t i = 0; i < slots; ++i) {
+            if (!alive[i]) continue;
+            double m = (static_cast<Agent::Type>(types[i]) == Agent::Type::PREY)
+                           ? config.MR : config.MF;
+            Position dir = randomDirection();
+            Position newPosition = confinePosition({xs[i] + dir.x * m, ys[i] + dir.y * m});
+            moveHandles.push_back(static_cast<AgentHandle>(i));
+            movePositions.push_back(newPosition);
+        }
+    }
+
+    // Phase 2: commit all moves and spatial-index updates in one pass
+    {
+        instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kMoveAgent);
+        grid.applyMoves(moveHandles, movePositions);
+    }
+
+    // Phase 3: answer every interaction query in one pass, sharing the
+    // neighborhood gather between agents in the same cell
+    static thread_local std::vector<uint8_t> interactionFlags;
+    {
+        instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kNeighborQuery);
+        grid.computeInteractionFlags(config.interactionRadius, interactionFlags);
+    }
+
+    // Phase 4: apply actions, with the same extinction early-out and
+    // birth/death handling as the interleaved path. The action draws and
+    // the birth/death bookkeeping are one fused pass here, so the whole
+    // phase lands in the births/deaths bucket.
+    {
+        instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kBirthsDeaths);
+        for (AgentHandle handle : moveHandles) {
+            if (getCurrentPredatorCount() == 0) {
+                setPreyCount(config.NR);
+                break;
+            }
+            if (!store.isAlive(handle)) continue;
+            auto agent = store.get(handle);
+            if (!agent || !agent->isAlive()) continue;
+
+            bool hasInteraction = interactionFlags[handle] != 0;
+            if (hasInteraction && agent->getType() == Agent::PREDATOR) {
+                predatorInteractedThisStep.store(true, std::memory_order_relaxed);
+            }
+            AgentAction::Action action = agent->getAction(hasInteraction);
+            if (action == AgentAction::Action::REPRODUCE) {
+                Position pos = agent->getPosition();
+                if (agent->getType() == Agent::Type::PREY) {
+                    if (getCurrentPreyCount() < config.NR) {
+                        grid.addAgent(agentPool.makePrey(pos, context));
+                        incrementPreyCount();
+                    }
+                } else {
+                    grid.addAgent(agentPool.makePredator(pos, context));
+                    incrementPredatorCount();
+                }
+            } else if (action == AgentAction::Action::DIE) {
+                agent->die();
+                grid.removeAgent(agent);
+                if (agent->getType() == Agent::Type::PREY) {
+                    decrementPreyCount();
+                } else {
+                    decrementPredatorCount();
+                }
+            }
+        }
+    }
+
+    finalizeStep();
+}
+
+void SimulationController::updateSingleTimestepParallel() {
+    const SimulationConfig& config = context.getConfig();
+    const int cellsW = grid.cellsWide();
+    const int cellsH = grid.cellsHigh();
+    // Tile geometry follows the grid's actual cell size, which may have
+    // been auto-tuned away from config.cellSize
+    const double cellSize = grid.getCellSize();
+    const int cellRadius = static_cast<int>(std::ceil(config.interactionRadius / cellSize));
+    const int moveCells = static_cast<int>(std::ceil(std::max(config.MF, config.MR) / cellSize));
+
+    // Tiles must be wide enough that two agents updated concurrently (same
+    // checkerboard color) can neither interact nor have the search window
+    // around their moved position reach into each other's cells
+    const int tileSize = cellRadius + moveCells + 1;
+    const int tilesX = (cellsW + tileSize - 1) / tileSize;
+    const int tilesY = (cellsH + tileSize - 1) / tileSize;
+
+    // One stamp epoch per timestep; a zero-filled restart covers the
+    // (theoretical) wrap so stale entries can never collide
+    if (++tiledStepEpoch == 0) {
+        std::fill(tiledStepStamp.begin(), tiledStepStamp.end(), 0);
+        tiledStepEpoch = 1;
+    }
+    if (tiledStepStamp.size() < grid.getStore().capacity()) {
+        tiledStepStamp.resize(grid.getStore().capacity(), 0);
+    }
+
+    // Four color phases: (tx odd/even, ty odd/even). Within a phase the
+    // grid is read-only; moves, births and deaths are queued and applied
+    // on the main thread at the phase boundary.
+    for (int color = 0; color < 4; ++color) {
+        if (getCurrentPredatorCount() == 0) {
+            setPreyCount(config.NR);
             break;
         }
-        size_t idx = indices[i];
-        if (idx < agents.size()) {  // Safety check
-            auto agent = agents[idx];
-            if (agent && agent->isAlive()) {
-                updateSingleAgent(agent);
+
+        TileStepChanges changes;
+        std::mutex changesMutex;
+        std::vector<std::future<void>> tasks;
+
+        for (int ty = (color >> 1); ty < tilesY; ty += 2) {
+            for (int tx = (color & 1); tx < tilesX; tx += 2) {
+                tasks.push_back(stepPool->enqueue(
+                        [this, tx, ty, tileSize, cellsW, cellsH, &changes, &changesMutex] {
+                    TileStepChanges local;
+                    const int x0 = tx * tileSize;
+                    const int y0 = ty * tileSize;
+                    const int x1 = std::min(cellsW, x0 + tileSize);
+                    const int y1 = std::min(cellsH, y0 + tileSize);
+
+                    for (int y = y0; y < y1; ++y) {
+                        for (int x = x0; x < x1; ++x) {
+                            for (AgentHandle handle : grid.cellAgents(x, y)) {
+                                if (tiledStepStamp[handle] == tiledStepEpoch) {
+                                    // Already updated this timestep: the
+                                    // agent moved in from an earlier color
+                                    continue;
+                                }
+                                auto agent = grid.getStore().get(handle);
+                                if (agent && agent->isAlive()) {
+                                    tiledStepStamp[handle] = tiledStepEpoch;
+                                    updateAgentTiled(agent, local);
+                                }
+                            }
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(changesMutex);
+                    changes.births.insert(changes.births.end(),
+                                          local.births.begin(), local.births.end());
+                    changes.deaths.insert(changes.deaths.end(),
+                                          local.deaths.begin(), local.deaths.end());
+                }));
             }
         }
-    }   
-    
-    currentStep++;
-    updateHistory();
+        for (auto& task : tasks) {
+            task.get();
+        }
+
+        // Commit queued moves, then births and deaths, on the main thread
+        grid.applyPendingChanges();
+        for (const auto& [type, pos] : changes.births) {
+            std::shared_ptr<Agent> newborn;
+            if (type == Agent::Type::PREY) {
+                // Re-check carrying capacity against the committed count
+                if (getCurrentPreyCount() < config.NR) {
+                    newborn = agentPool.makePrey(pos, context);
+                    incrementPreyCount();
+                }
+            } else {
+                newborn = agentPool.makePredator(pos, context);
+                incrementPredatorCount();
+            }
+            if (newborn) {
+                grid.addAgent(newborn);
+                // Stamp so later phases do not step the newborn in its
+                // birth step; its slot may lie past the step's resize
+                AgentHandle handle = newborn->getHandle();
+                if (handle >= tiledStepStamp.size()) {
+                    tiledStepStamp.resize(handle + 1, 0);
+                }
+                tiledStepStamp[handle] = tiledStepEpoch;
+            }
+        }
+        for (const auto& agent : changes.deaths) {
+            agent->die();
+            grid.removeAgent(agent);
+            if (agent->getType() == Agent::Type::PREY) {
+                decrementPreyCount();
+            } else {
+                decrementPredatorCount();
+            }
+        }
+    }
+
+    finalizeStep();
 }
 
+void SimulationController::updateAgentTiled(const std::shared_ptr<Agent>& agent,
+                                            TileStepChanges& changes) {
+    double m = (agent->getType() == Agent::Type::PREY) ?
+               context.getConfig().MR :
+               context.getConfig().MF;
+
+    Position oldPosition = agent->getPosition();
+    Position newPosition = confinePosition(agent->getPosition() + randomDirection() * m);
+
+    // Only this worker touches the agent object; the store and spatial
+    // grid stay untouched until the queued move is applied at the barrier
+    agent->setPosition(newPosition);
+    grid.queueAgentMove(agent, oldPosition);
+
+    bool hasInteraction = grid.hasOppositeTypeNeighborAt(
+        agent, newPosition, context.getConfig().interactionRadius);
+    if (hasInteraction && agent->getType() == Agent::PREDATOR) {
+        predatorInteractedThisStep.store(true, std::memory_order_relaxed);
+    }
+    AgentAction::Action action = agent->getAction(hasInteraction);
+
+    if (action == AgentAction::Action::REPRODUCE) {
+        changes.births.emplace_back(agent->getType(), newPosition);
+    } else if (action == AgentAction::Action::DIE) {
+        changes.deaths.push_back(agent);
+    }
+}
 
 void SimulationController::updateSingleAgent(std::shared_ptr<Agent> agent){
     if (!isRunning && isPaused) { return; }    
@@ -137,33 +769,47 @@ void SimulationController::updateSingleAgent(std::shared_ptr<Agent> agent){
                    context.getConfig().MR : 
                    context.getConfig().MF;
 
-        // Clamp the new position to the grid
+        // Keep the new position inside the world (clamped or wrapped)
         Position oldPosition = agent->getPosition();
-        Position newPosition = agent->getPosition() + randomDirection() * m;
-        newPosition.x = std::clamp(newPosition.x, 0.0, 1.0);
-        newPosition.y = std::clamp(newPosition.y, 0.0, 1.0);
+        Position newPosition = oldPosition;
+        {
+            instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kMovement);
+            newPosition = confinePosition(agent->getPosition() + randomDirection() * m);
 
-        // Make sure to update the agent's internal position too
-        // This should be the only place where the agent's position is updated
-        agent->setPosition(newPosition);
-        grid.moveAgent(agent, oldPosition, newPosition);
+            // Make sure to update the agent's internal position too
+            // This should be the only place where the agent's position is updated
+            agent->setPosition(newPosition);
+        }
+        {
+            instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kMoveAgent);
+            grid.moveAgent(agent, oldPosition, newPosition);
+        }
 
-        bool hasInteraction = grid.hasOppositeTypeNeighbor(agent, context.getConfig().interactionRadius);
+        bool hasInteraction = interactionCheck(agent);
+        if (hasInteraction && agent->getType() == Agent::PREDATOR) {
+            predatorInteractedThisStep.store(true, std::memory_order_relaxed);
+        }
 
-        AgentAction::Action action = agent->getAction(hasInteraction);  
+        AgentAction::Action action;
+        {
+            instrumentation::ScopedTimer timer(stepMetrics, instrumentation::kAction);
+            action = agent->getAction(hasInteraction);
+        }
 
+        instrumentation::ScopedTimer birthsDeathsTimer(stepMetrics,
+                                                       instrumentation::kBirthsDeaths);
         if (action == AgentAction::Action::REPRODUCE) {
             std::shared_ptr<Agent> newAgent;
             if (agent->getType() == Agent::Type::PREY) {
                 // Double-check carrying capacity before actually creating the agent
                 if (getCurrentPreyCount() < context.getConfig().NR) {
-                    newAgent = std::make_shared<Prey>(newPosition, context);
+                    newAgent = agentPool.makePrey(newPosition, context);
                     incrementPreyCount();
                     grid.addAgent(newAgent);
-                } 
-            }   
+                }
+            }
             else {
-                newAgent = std::make_shared<Predator>(newPosition, context);
+                newAgent = agentPool.makePredator(newPosition, context);
                 incrementPredatorCount();
                 grid.addAgent(newAgent);
 
@@ -189,12 +835,38 @@ void SimulationController::run() {
     // }
     if (isRunning && !isPaused) {
         updateSingleTimestep();
+
+        const SimulationConfig& config = context.getConfig();
+        if (config.checkpointInterval > 0 &&
+            currentStep % config.checkpointInterval == 0) {
+            saveCheckpoint(config.checkpointFile);
+        }
     }
 }
 
 void SimulationController::runForTimesteps(int numSteps) {
+    const SimulationConfig& config = context.getConfig();
+    if (!config.earlyTermination) {
+        for (int i = 0; i < numSteps; ++i) {
+            run();
+        }
+        return;
+    }
+
+    ConvergenceDetector detector(config.convergenceBurnIn,
+                                 config.convergenceWindow,
+                                 config.convergenceTolerance);
     for (int i = 0; i < numSteps; ++i) {
         run();
+        // Predator extinction is absorbing: prey is pinned at NR from
+        // here on, so further stepping cannot change the statistics
+        if (getCurrentPredatorCount() == 0) {
+            break;
+        }
+        if (detector.shouldCheck(currentStep) &&
+            detector.converged(predatorHistory, preyHistory)) {
+            break;
+        }
     }
 }
 
@@ -206,6 +878,228 @@ void SimulationController::end() {
     isRunning = false;
     isPaused = false;
     endTime = std::chrono::steady_clock::now();
+    if (trajectoryRecorder) {
+        trajectoryRecorder->finish();
+    }
+}
+
+void SimulationController::enableTrajectoryRecording(const std::string& path) {
+    trajectoryRecorder = std::make_unique<TrajectoryRecorder>(path);
+}
+
+std::shared_ptr<LiveViewBuffer> SimulationController::enableLiveView(
+        int agentStride, int frameInterval) {
+    liveViewStride = std::max(agentStride, 1);
+    liveViewInterval = std::max(frameInterval, 1);
+    liveViewBuffer = std::make_shared<LiveViewBuffer>();
+    return liveViewBuffer;
+}
+
+void SimulationController::publishLiveFrame() {
+    LiveViewBuffer::Frame* frame = liveViewBuffer->beginWrite();
+    if (!frame) {
+        return;  // viewer a full ring behind; drop rather than block
+    }
+
+    frame->step = static_cast<uint32_t>(currentStep);
+    frame->predators = getCurrentPredatorCount();
+    frame->prey = getCurrentPreyCount();
+
+    // Snapshot every strideth live agent from the store's contiguous
+    // arrays; the frame vectors keep their capacity between frames
+    frame->xs.clear();
+    frame->ys.clear();
+    frame->types.clear();
+    const AgentStore& store = grid.getStore();
+    const size_t slots = store.capacity();
+    const uint8_t* alive = store.aliveData();
+    const uint8_t* types = store.typeData();
+    const double* xs = store.xData();
+    const double* ys = store.yData();
+    int seen = 0;
+    for (size_t i = 0; i < slots; ++i) {
+        if (!alive[i]) continue;
+        if (seen++ % liveViewStride != 0) continue;
+        frame->xs.push_back(static_cast<float>(xs[i]));
+        frame->ys.push_back(static_cast<float>(ys[i]));
+        frame->types.push_back(types[i]);
+    }
+
+    liveViewBuffer->commitWrite();
+}
+
+void SimulationController::saveCheckpoint(const std::string& path) {
+    // Assemble the whole image in memory so the file write is one call
+    std::vector<uint8_t> image;
+    const AgentStore& store = grid.getStore();
+    image.reserve(64 + (predatorHistory.size() + preyHistory.size()) * sizeof(int32_t)
+                  + store.size() * (2 * sizeof(double) + sizeof(uint8_t) + sizeof(uint64_t)));
+
+    image.insert(image.end(), kCheckpointMagic, kCheckpointMagic + sizeof(kCheckpointMagic));
+    appendRaw(image, context.getSeed());
+    appendRaw(image, context.getStreamId());
+    appendRaw(image, context.getRNG().getCounter());
+    appendRaw(image, context.getNextStreamCursor());
+    appendRaw(image, static_cast<int32_t>(currentStep));
+    appendRaw(image, static_cast<int32_t>(predatorCount));
+    appendRaw(image, static_cast<int32_t>(preyCount));
+    appendRaw(image, static_cast<int32_t>(Agent::peekIdCounter()));
+
+    appendRaw(image, static_cast<uint32_t>(predatorHistory.size()));
+    for (int v : predatorHistory) appendRaw(image, static_cast<int32_t>(v));
+    appendRaw(image, static_cast<uint32_t>(preyHistory.size()));
+    for (int v : preyHistory) appendRaw(image, static_cast<int32_t>(v));
+
+    // Agents are serialized in the grid's current iteration order, not
+    // slot order: restore re-adds them in table order, so the rebuilt
+    // iteration order is the same agent sequence the uninterrupted run
+    // would compact to, and the next shuffle permutes identical input
+    appendRaw(image, static_cast<uint32_t>(store.size()));
+    grid.forEachAgentInOrder([&](const std::shared_ptr<Agent>& agent) {
+        AgentHandle handle = agent->getHandle();
+        appendRaw(image, store.x(handle));
+        appendRaw(image, store.y(handle));
+        appendRaw(image, static_cast<uint8_t>(store.type(handle)));
+        appendRaw(image, static_cast<uint64_t>(agent->getId()));
+        return true;
+    });
+
+    // Write to a sibling temp file, then atomically rename into place so
+    // a preemption mid-write never leaves a truncated checkpoint
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to open checkpoint temp file: " << tmpPath << std::endl;
+            return;
+        }
+        out.write(reinterpret_cast<const char*>(image.data()),
+                  static_cast<std::streamsize>(image.size()));
+        if (!out) {
+            std::cerr << "Failed to write checkpoint: " << tmpPath << std::endl;
+            return;
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Failed to rename checkpoint into place: " << path << std::endl;
+    }
+}
+
+bool SimulationController::loadCheckpoint(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    std::vector<uint8_t> image(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(image.data()),
+            static_cast<std::streamsize>(image.size()));
+    if (!in) return false;
+
+    size_t offset = 0;
+    if (image.size() < sizeof(kCheckpointMagic) ||
+        std::memcmp(image.data(), kCheckpointMagic, sizeof(kCheckpointMagic)) != 0) {
+        return false;
+    }
+    offset += sizeof(kCheckpointMagic);
+
+    uint64_t seed, streamId, rngCounter, nextStreamCursor;
+    int32_t step, savedPredators, savedPrey, nextAgentId;
+    if (!readRaw(image, offset, seed) || !readRaw(image, offset, streamId) ||
+        !readRaw(image, offset, rngCounter) || !readRaw(image, offset, nextStreamCursor) ||
+        !readRaw(image, offset, step) || !readRaw(image, offset, savedPredators) ||
+        !readRaw(image, offset, savedPrey) || !readRaw(image, offset, nextAgentId)) {
+        return false;
+    }
+
+    uint32_t predatorHistorySize, preyHistorySize;
+    if (!readRaw(image, offset, predatorHistorySize)) return false;
+    std::vector<int> loadedPredatorHistory(predatorHistorySize);
+    for (uint32_t i = 0; i < predatorHistorySize; ++i) {
+        int32_t v;
+        if (!readRaw(image, offset, v)) return false;
+        loadedPredatorHistory[i] = v;
+    }
+    if (!readRaw(image, offset, preyHistorySize)) return false;
+    std::vector<int> loadedPreyHistory(preyHistorySize);
+    for (uint32_t i = 0; i < preyHistorySize; ++i) {
+        int32_t v;
+        if (!readRaw(image, offset, v)) return false;
+        loadedPreyHistory[i] = v;
+    }
+
+    uint32_t agentCount;
+    if (!readRaw(image, offset, agentCount)) return false;
+
+    // The image is fully validated up to the agent table; commit state now
+    grid.clearAll();
+    setPredatorCount(0);
+    setPreyCount(0);
+
+    for (uint32_t i = 0; i < agentCount; ++i) {
+        double x, y;
+        uint8_t type;
+        uint64_t id;
+        if (!readRaw(image, offset, x) || !readRaw(image, offset, y) ||
+            !readRaw(image, offset, type) || !readRaw(image, offset, id)) {
+            return false;
+        }
+        Position pos{x, y};
+        std::shared_ptr<Agent> agent;
+        if (static_cast<Agent::Type>(type) == Agent::Type::PREY) {
+            agent = agentPool.makePrey(pos, context, static_cast<size_t>(id));
+            incrementPreyCount();
+        } else {
+            agent = agentPool.makePredator(pos, context, static_cast<size_t>(id));
+            incrementPredatorCount();
+        }
+        grid.addAgent(agent);
+    }
+
+    if (predatorCount != savedPredators || preyCount != savedPrey) {
+        std::cerr << "Checkpoint counts disagree with agent table: "
+                  << predatorCount << "/" << savedPredators << " predators, "
+                  << preyCount << "/" << savedPrey << " prey" << std::endl;
+    }
+
+    predatorHistory = std::move(loadedPredatorHistory);
+    preyHistory = std::move(loadedPreyHistory);
+
+    // Replay the restored histories through the incremental statistics
+    // so O(1) readers see the whole run, not just the resumed tail
+    predatorStats.reset();
+    preyStats.reset();
+    predatorSeries.reset();
+    preySeries.reset();
+    extinctionStep = -1;
+    for (size_t i = 0; i < predatorHistory.size(); ++i) {
+        predatorStats.add(predatorHistory[i]);
+        predatorSeries.add(predatorHistory[i]);
+        if (extinctionStep < 0 && predatorHistory[i] == 0) {
+            extinctionStep = static_cast<int>(i);
+        }
+    }
+    for (int v : preyHistory) {
+        preyStats.add(v);
+        preySeries.add(v);
+    }
+
+    currentStep = step;
+    Agent::setIdCounter(nextAgentId);
+    context.restoreRngState(seed, streamId, rngCounter, nextStreamCursor);
+
+    if (grid.spatialRebuildEnabled()) {
+        grid.rebuildSpatialIndex();
+    }
+
+    // The regime detector re-earns its quiet streak on the resumed run
+    meanFieldDecayActive = false;
+    quietPredatorSteps = 0;
+    meanFieldDeathDebt = 0.0;
+    predatorInteractedThisStep.store(false, std::memory_order_relaxed);
+
+    isRunning = true;
+    isPaused = false;
+    startTime = std::chrono::steady_clock::now();
+    return true;
 }
 
 SimulationStats SimulationController::getCurrentStats() const {
@@ -260,19 +1154,30 @@ void SimulationController::resetStats() {
     grid.clearAll();
 }
 
-SimulationReport SimulationController::getReport() const {
+SimulationReport SimulationController::getReport() {
     auto executionTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-    
+
     SimulationReport report(
-        predatorHistory, 
-        preyHistory,                  
+        std::move(predatorHistory),
+        std::move(preyHistory),
         getCurrentPredatorCount(),
         getCurrentPreyCount(),                  
         context.getConfig(),
         currentStep,
         executionTime,
-        static_cast<double>(preyCount)/context.getConfig().NR
+        static_cast<double>(preyCount)/context.getConfig().NR,
+        context.getSeed()
     );
-    
+
+    // Attach the run's hot-path instrumentation: phase timers plus the
+    // spatial query counters, all zeroed in default builds
+    auto spatial = grid.spatialStats();
+    instrumentation::QueryCounters counters;
+    counters.queries = spatial.queries;
+    counters.candidates = spatial.candidates;
+    counters.hits = spatial.hits;
+    counters.cellMigrations = spatial.cellMigrations;
+    report.setInstrumentation(stepMetrics, counters);
+
     return report;
 } 
\ No newline at end of file
@@ -3,26 +3,23 @@
 #include <algorithm>
 #include <SFML/Graphics.hpp>
 
-void SimulationReport::visualize() {
-    sf::RenderWindow window(sf::VideoMode(sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT)), "Simulation Report");
-    window.setFramerateLimit(60);
+// SFML plotting for SimulationReport. This translation unit is the only
+// place the core data types touch the graphics stack; it is compiled
+// into the predator_prey_viz target so headless builds skip it entirely.
 
-    while (window.isOpen()) {
-        if (const auto event = window.pollEvent()) {
-            if (event->is<sf::Event::Closed>()) {
-                window.close();
-            }
-        }
+namespace {
 
-        window.clear(sf::Color::White);
-        drawAxes(window);
-        drawGraph(window);
-        drawLegend(window);
-        window.display();
-    }
+constexpr unsigned int WINDOW_WIDTH = 800;
+constexpr unsigned int WINDOW_HEIGHT = 600;
+constexpr float MARGIN = 50.f;
+
+sf::Vector2f mapToScreen(float x, float y) {
+    float screenX = MARGIN + x * (WINDOW_WIDTH - 2 * MARGIN);
+    float screenY = WINDOW_HEIGHT - MARGIN - y * (WINDOW_HEIGHT - 2 * MARGIN);
+    return sf::Vector2f(screenX, screenY);
 }
 
-void SimulationReport::drawAxes(sf::RenderWindow& window) const {
+void drawAxes(sf::RenderWindow& window) {
     // Create vertex arrays for x and y axes
     sf::VertexArray xAxis(sf::PrimitiveType::Lines, 2);
     sf::VertexArray yAxis(sf::PrimitiveType::Lines, 2);
@@ -43,7 +40,9 @@ void SimulationReport::drawAxes(sf::RenderWindow& window) const {
     window.draw(yAxis);
 }
 
-void SimulationReport::drawGraph(sf::RenderWindow& window) const {
+void drawGraph(sf::RenderWindow& window,
+               const std::vector<int>& predator_history,
+               const std::vector<int>& prey_history) {
     if (prey_history.empty() || predator_history.empty()) return;
 
     // Find max values for scaling
@@ -70,13 +69,13 @@ void SimulationReport::drawGraph(sf::RenderWindow& window) const {
     window.draw(preyLine);
 }
 
-void SimulationReport::drawLegend(sf::RenderWindow& window) const {
+void drawLegend(sf::RenderWindow& window) {
     // Create vertex arrays for legend lines
     sf::VertexArray predatorLegend(sf::PrimitiveType::Lines, 2);
     sf::VertexArray preyLegend(sf::PrimitiveType::Lines, 2);
 
     float legendY = MARGIN + 20;
-    
+
     // Predator legend line
     predatorLegend[0].position = sf::Vector2f(WINDOW_WIDTH - MARGIN - 50, legendY);
     predatorLegend[1].position = sf::Vector2f(WINDOW_WIDTH - MARGIN - 30, legendY);
@@ -93,8 +92,23 @@ void SimulationReport::drawLegend(sf::RenderWindow& window) const {
     window.draw(preyLegend);
 }
 
-sf::Vector2f SimulationReport::mapToScreen(float x, float y) const {
-    float screenX = MARGIN + x * (WINDOW_WIDTH - 2 * MARGIN);
-    float screenY = WINDOW_HEIGHT - MARGIN - y * (WINDOW_HEIGHT - 2 * MARGIN);
-    return sf::Vector2f(screenX, screenY);
-} 
+}  // namespace
+
+void SimulationReport::visualize() {
+    sf::RenderWindow window(sf::VideoMode(sf::Vector2u(WINDOW_WIDTH, WINDOW_HEIGHT)), "Simulation Report");
+    window.setFramerateLimit(60);
+
+    while (window.isOpen()) {
+        if (const auto event = window.pollEvent()) {
+            if (event->is<sf::Event::Closed>()) {
+                window.close();
+            }
+        }
+
+        window.clear(sf::Color::White);
+        drawAxes(window);
+        drawGraph(window, predator_history, prey_history);
+        drawLegend(window);
+        window.display();
+    }
+}
@@ -0,0 +1,100 @@
+#include "trajectory_recorder.hpp"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// Fixed 6-byte agent record, matching the layout documented in the header
+struct AgentRecord {
+    uint16_t qx;
+    uint16_t qy;
+    uint8_t type;
+    uint8_t pad;
+};
+static_assert(sizeof(AgentRecord) == 6, "trajectory record must be 6 bytes");
+
+uint16_t quantize(double v) {
+    // Positions are clamped to the unit world by the movement code
+    return static_cast<uint16_t>(std::lround(v * 65535.0));
+}
+
+template <typename T>
+void appendRaw(std::vector<uint8_t>& buffer, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+}  // namespace
+
+TrajectoryRecorder::TrajectoryRecorder(const std::string& path)
+    : out(path, std::ios::binary | std::ios::trunc) {
+    if (!out) {
+        throw std::runtime_error("Failed to open trajectory file: " + path);
+    }
+    out.write("PPTRAJ01", 8);
+    writer = std::thread(&TrajectoryRecorder::writerLoop, this);
+}
+
+TrajectoryRecorder::~TrajectoryRecorder() {
+    finish();
+}
+
+void TrajectoryRecorder::recordStep(uint32_t step, const AgentStore& store) {
+    const size_t slots = store.capacity();
+    const double* xs = store.xData();
+    const double* ys = store.yData();
+    const uint8_t* types = store.typeData();
+    const uint8_t* alive = store.aliveData();
+
+    appendRaw(fillBuffer, step);
+    appendRaw(fillBuffer, static_cast<uint32_t>(store.size()));
+    for (size_t i = 0; i < slots; ++i) {
+        if (!alive[i]) continue;
+        AgentRecord record{quantize(xs[i]), quantize(ys[i]), types[i], 0};
+        appendRaw(fillBuffer, record);
+    }
+
+    if (fillBuffer.size() >= kFlushThreshold) {
+        handOff();
+    }
+}
+
+void TrajectoryRecorder::handOff() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queued.push_back(std::move(fillBuffer));
+    }
+    fillBuffer.clear();
+    queueReady.notify_one();
+}
+
+void TrajectoryRecorder::finish() {
+    if (!writer.joinable()) return;
+    if (!fillBuffer.empty()) {
+        handOff();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        done = true;
+    }
+    queueReady.notify_one();
+    writer.join();
+    out.flush();
+}
+
+void TrajectoryRecorder::writerLoop() {
+    for (;;) {
+        std::vector<std::vector<uint8_t>> batch;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return done || !queued.empty(); });
+            if (queued.empty() && done) return;
+            batch.swap(queued);
+        }
+        for (const auto& buffer : batch) {
+            out.write(reinterpret_cast<const char*>(buffer.data()),
+                      static_cast<std::streamsize>(buffer.size()));
+        }
+    }
+}